@@ -0,0 +1,386 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+#include <stdint.h>
+#include "chess_core.h"
+#include "bits.h"
+#include "shifts.h"
+#include "see.h"
+#include "book.h"
+#include "mailbox.h"
+#include "bench.h"
+
+#ifdef BENCH
+
+#ifdef __AVR__
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+// Number of inputs per kernel (kept small so the device finishes in seconds)
+#ifdef __AVR__
+#define BENCH_INPUTS 32
+#else
+#define BENCH_INPUTS 4096
+#endif
+
+/* Cycle counter */
+
+#ifdef __AVR__
+
+static volatile uint16_t bench_overflows;
+
+ISR(TIMER3_OVF_vect) {
+    bench_overflows++;
+}
+
+void bench_init() {
+    // Timer 3 free running at F_CPU, overflow extends it to 32 bits
+    TCCR3A = 0;
+    TCCR3B = _BV(CS30);
+    TIMSK3 |= _BV(TOIE3);
+    sei();
+}
+
+uint32_t bench_cycles() {
+    uint8_t sreg = SREG;
+    cli();
+    uint16_t lo = TCNT3;
+    uint16_t hi = bench_overflows;
+    // An overflow may be pending if the counter wrapped since interrupts were disabled
+    if ((TIFR3 & _BV(TOV3)) && lo < 0x8000) hi++;
+    SREG = sreg;
+    return ((uint32_t) hi << 16) | lo;
+}
+
+#else
+
+void bench_init() {
+}
+
+uint32_t bench_cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return (uint32_t) __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t) (ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+#endif
+}
+
+#endif
+
+/* Deterministic xorshift stream so both targets see the same inputs */
+
+static uint64_t bench_state = 0x9E3779B97F4A7C15ULL;
+
+uint64_t bench_random() {
+    bench_state ^= bench_state << 13;
+    bench_state ^= bench_state >> 7;
+    bench_state ^= bench_state << 17;
+    return bench_state;
+}
+
+/* Inputs: a quarter-full occupancy and one slider sitting on it,
+ * plus a sparse (about eight square) set standing in for a pawn chain */
+
+static uint64_t occupancy[BENCH_INPUTS];
+static uint64_t slider[BENCH_INPUTS];
+static uint64_t piece_set[BENCH_INPUTS];
+
+static void make_inputs() {
+    for (uint16_t i = 0; i < BENCH_INPUTS; i++) {
+        uint64_t sq = (uint64_t) 1 << (bench_random() & 63);
+        occupancy[i] = (bench_random() & bench_random()) | sq;
+        slider[i] = sq;
+        piece_set[i] = bench_random() & bench_random() & bench_random();
+    }
+}
+
+// Defeats dead code elimination of the measured calls
+static volatile uint64_t bench_sink;
+
+typedef uint64_t (*slider_kernel)(uint64_t, uint64_t);
+
+static uint32_t time_slider(slider_kernel kernel) {
+    uint64_t acc = 0;
+    uint32_t start = bench_cycles();
+    for (uint16_t i = 0; i < BENCH_INPUTS; i++) {
+        acc ^= kernel(slider[i], occupancy[i]);
+    }
+    uint32_t cycles = bench_cycles() - start;
+    bench_sink = acc;
+    return cycles / BENCH_INPUTS;
+}
+
+typedef uint64_t (*leaper_kernel)(uint64_t);
+
+static uint32_t time_leaper(leaper_kernel kernel, const uint64_t* input) {
+    uint64_t acc = 0;
+    uint32_t start = bench_cycles();
+    for (uint16_t i = 0; i < BENCH_INPUTS; i++) {
+        acc ^= kernel(input[i]);
+    }
+    uint32_t cycles = bench_cycles() - start;
+    bench_sink = acc;
+    return cycles / BENCH_INPUTS;
+}
+
+/* Rank and diagonal steps as plain 64-bit shifts, against the byte steps of
+ * shifts.h: a libgcc call against byte moves. Device only, as on the host both
+ * are one instruction and fold away inside the timing loop. */
+
+#ifdef __AVR__
+
+static uint64_t shift_8_generic(uint64_t b) {
+    return b << 8;
+}
+
+static uint64_t shift_8_bytes(uint64_t b) {
+    return north(b);
+}
+
+static uint64_t shift_7_generic(uint64_t b) {
+    return (b & clear_file[FILE_A]) << 7;
+}
+
+static uint64_t shift_7_bytes(uint64_t b) {
+    return north(west(b));
+}
+
+static uint64_t shift_9_generic(uint64_t b) {
+    return (b & clear_file[FILE_H]) << 9;
+}
+
+static uint64_t shift_9_bytes(uint64_t b) {
+    return north(east(b));
+}
+
+#endif
+
+/* Visiting the squares of sparse sets (about eight pieces), testing all 64
+ * squares against walking the set bits */
+static uint32_t time_square_scan() {
+    uint16_t acc = 0;
+    uint32_t start = bench_cycles();
+    for (uint16_t i = 0; i < BENCH_INPUTS; i++) {
+        for (uint8_t sq = 0; sq < BOARD_SIZE * BOARD_SIZE; sq++) {
+            if (piece_set[i] & piece[sq]) acc += sq;
+        }
+    }
+    uint32_t cycles = bench_cycles() - start;
+    bench_sink = acc;
+    return cycles / BENCH_INPUTS;
+}
+
+static uint32_t time_for_each_bit() {
+    uint16_t acc = 0;
+    uint32_t start = bench_cycles();
+    for (uint16_t i = 0; i < BENCH_INPUTS; i++) {
+        for_each_bit(sq, piece_set[i]) {
+            acc += sq;
+        }
+    }
+    uint32_t cycles = bench_cycles() - start;
+    bench_sink = acc;
+    return cycles / BENCH_INPUTS;
+}
+
+/* Exchange evaluation, against generating every legal move, on a busy middlegame.
+ * Inputs are the enemy pieces each side attacks, encoded as square + 64 * side. */
+
+static move_list bench_moves;
+static uint8_t see_inputs[2 * BOARD_SIZE * BOARD_SIZE];
+static uint8_t see_count;
+
+static void make_see_inputs() {
+    see_count = 0;
+    for (uint8_t side = PLAYER_WHITE; side <= PLAYER_BLACK; side++) {
+        uint64_t targets = get_attacks(side)->all & bitboards[(side == PLAYER_WHITE) ? B_ALL : W_ALL];
+        for_each_bit(sq, targets) {
+            see_inputs[see_count++] = sq + BOARD_SIZE * BOARD_SIZE * side;
+        }
+    }
+}
+
+static uint32_t time_see() {
+    int16_t acc = 0;
+    uint32_t start = bench_cycles();
+    for (uint8_t i = 0; i < see_count; i++) {
+        acc += see(see_inputs[i] & 63, see_inputs[i] >> 6);
+    }
+    uint32_t cycles = bench_cycles() - start;
+    bench_sink = acc;
+    return cycles / see_count;
+}
+
+static uint32_t time_see_ge() {
+    uint8_t acc = 0;
+    uint32_t start = bench_cycles();
+    for (uint8_t i = 0; i < see_count; i++) {
+        acc += see_ge(see_inputs[i] & 63, see_inputs[i] >> 6, 0);
+    }
+    uint32_t cycles = bench_cycles() - start;
+    bench_sink = acc;
+    return cycles / see_count;
+}
+
+static uint32_t time_generate_legal() {
+    uint16_t acc = 0;
+    uint32_t start = bench_cycles();
+    for (uint8_t i = 0; i < 16; i++) {
+        // Forget the cached check state so each call pays for it, as after a move
+        reset_check_info();
+        acc += generate_legal(&bench_moves);
+    }
+    uint32_t cycles = bench_cycles() - start;
+    bench_sink = acc;
+    return cycles / 16;
+}
+
+static uint32_t time_side_has_legal_move() {
+    uint8_t acc = 0;
+    uint32_t start = bench_cycles();
+    for (uint8_t i = 0; i < 16; i++) {
+        reset_check_info();
+        acc += side_has_legal_move();
+    }
+    uint32_t cycles = bench_cycles() - start;
+    bench_sink = acc;
+    return cycles / 16;
+}
+
+/* The 0x88 backend on the same position */
+static uint32_t time_mailbox_generate_legal() {
+    uint16_t acc = 0;
+    uint32_t start = bench_cycles();
+    for (uint8_t i = 0; i < 16; i++) {
+        acc += mailbox_generate_legal(&bench_moves);
+    }
+    uint32_t cycles = bench_cycles() - start;
+    bench_sink = acc;
+    return cycles / 16;
+}
+
+/* Two plies of perft on each backend (generation, make and unmake), per leaf */
+
+static uint16_t perft_bitboard() {
+    move_list list;
+    uint16_t nodes = 0;
+    generate_legal(&bench_moves);
+    list = bench_moves;
+    for (uint8_t i = 0; i < list.count; i++) {
+        make_move(list.moves[i]);
+        nodes += generate_legal(&bench_moves);
+        unmake_move();
+    }
+    return nodes;
+}
+
+static uint16_t perft_mailbox() {
+    move_list list;
+    uint16_t nodes = 0;
+    mailbox_generate_legal(&list);
+    for (uint8_t i = 0; i < list.count; i++) {
+        mailbox_make_move(list.moves[i]);
+        nodes += mailbox_generate_legal(&bench_moves);
+        mailbox_unmake_move();
+    }
+    return nodes;
+}
+
+static uint32_t time_perft(uint16_t (*perft)()) {
+    uint32_t start = bench_cycles();
+    uint16_t nodes = perft();
+    uint32_t cycles = bench_cycles() - start;
+    bench_sink = nodes;
+    return cycles / nodes;
+}
+
+/* Book probe of the start position: the key, the search and the legality check */
+static uint32_t time_book_move() {
+    uint16_t acc = 0;
+    uint32_t start = bench_cycles();
+    for (uint8_t i = 0; i < 16; i++) {
+        acc += book_move((uint16_t) i << 12);
+    }
+    uint32_t cycles = bench_cycles() - start;
+    bench_sink = acc;
+    return cycles / 16;
+}
+
+void run_benchmarks(bench_report report) {
+
+    bench_init();
+    load_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+    make_inputs();
+
+    report("rook loop", time_slider(rook_attacked_loop));
+    report("rook fill", time_slider(rook_attacked_fill));
+    report("rook table", time_slider(rook_attacked_table));
+    report("bishop loop", time_slider(bishop_attacked_loop));
+    report("bishop fill", time_slider(bishop_attacked_fill));
+    report("bishop table", time_slider(bishop_attacked_table));
+#ifndef __AVR__
+    if (cpu_has_pext()) {
+        init_sliders_magic(1);
+        report("rook pext", time_slider(rook_attacked_magic));
+        report("bishop pext", time_slider(bishop_attacked_magic));
+    }
+    init_sliders_magic(0);
+    report("rook magic", time_slider(rook_attacked_magic));
+    report("bishop magic", time_slider(bishop_attacked_magic));
+    init_sliders_magic(cpu_has_pext());
+#endif
+    report("queen", time_slider(queen_attacked));
+
+    report("knight shift", time_leaper(knight_attacked_shift, slider));
+    report("knight table", time_leaper(knight_attacked, slider));
+    report("king shift", time_leaper(king_attacked_shift, slider));
+    report("king table", time_leaper(king_attacked, slider));
+    report("pawn shift", time_leaper(white_pawn_attacked_shift, slider));
+    report("pawn table", time_leaper(white_pawn_attacked, slider));
+    report("pawns shift", time_leaper(white_pawn_attacked_shift, piece_set));
+    report("pawns table", time_leaper(white_pawn_attacked, piece_set));
+
+#ifdef __AVR__
+    report("shift 8 generic", time_leaper(shift_8_generic, piece_set));
+    report("shift 8 bytes", time_leaper(shift_8_bytes, piece_set));
+    report("shift 7 generic", time_leaper(shift_7_generic, piece_set));
+    report("shift 7 bytes", time_leaper(shift_7_bytes, piece_set));
+    report("shift 9 generic", time_leaper(shift_9_generic, piece_set));
+    report("shift 9 bytes", time_leaper(shift_9_bytes, piece_set));
+#endif
+
+    report("square scan", time_square_scan());
+    report("for_each_bit", time_for_each_bit());
+
+    load_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+    report("book_move", time_book_move());
+
+    load_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    make_see_inputs();
+    report("see", time_see());
+    report("see_ge", time_see_ge());
+    report("generate_legal", time_generate_legal());
+    report("side_has_legal_move", time_side_has_legal_move());
+
+    // Bitboards against the 0x88 mailbox prototype, both with check and pin aware legality
+    mailbox_load_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+    report("mailbox generate_legal", time_mailbox_generate_legal());
+    report("perft 2 bitboard", time_perft(perft_bitboard));
+    report("perft 2 mailbox", time_perft(perft_mailbox));
+
+    // Mated, the most the early exit can cost
+    load_fen("rnb1kbnr/pppp1ppp/8/4p3/6Pq/5P2/PPPPP2P/RNBQKBNR w KQkq - 1 3");
+    report("generate_legal mated", time_generate_legal());
+    report("side_has_legal mated", time_side_has_legal_move());
+}
+
+#endif
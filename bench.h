@@ -0,0 +1,25 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+#ifndef bench_h
+#define bench_h
+
+#include <stdint.h>
+
+/* Cycle benchmarks for the core kernels.
+ *
+ * Only built when BENCH is defined (`make BENCH=1` for the device, always for
+ * the host). Results are average cycles per call: Timer3 ticks at F_CPU on the
+ * AVR, the time stamp counter on the host.
+ */
+
+typedef void (*bench_report)(const char* name, uint32_t cycles);
+
+void bench_init();
+uint32_t bench_cycles();
+uint64_t bench_random();
+void run_benchmarks(bench_report report);
+
+#endif
@@ -0,0 +1,60 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+#include <stdint.h>
+#include "bits.h"
+
+#ifdef __AVR__
+
+#include "progmem.h"
+
+// Lowest set bit of each byte (0 for the empty byte, never looked up)
+static const uint8_t lsb_table[256] PROGMEM = {
+    0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
+    4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
+    5, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
+    4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
+    6, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
+    4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
+    5, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
+    4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
+    7, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
+    4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
+    5, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
+    4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
+    6, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
+    4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
+    5, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0,
+    4, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0
+};
+
+// A bitboard as the bytes the AVR keeps it in, lowest first
+typedef union {
+    uint64_t bb;
+    uint8_t byte[8];
+} bytes;
+
+/* Index of the lowest set bit: skips the empty bytes, then looks the first
+ * other one up */
+uint8_t lsb(uint64_t b) {
+    bytes u;
+    u.bb = b;
+    uint8_t i = 0;
+    while (!u.byte[i]) i++;
+    return i * 8 + pgm_read_byte(&lsb_table[u.byte[i]]);
+}
+
+/* Number of set bits, a byte at a time, clearing the lowest until each is empty */
+uint8_t popcount(uint64_t b) {
+    bytes u;
+    u.bb = b;
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < 8; i++) {
+        for (uint8_t byte = u.byte[i]; byte; byte &= byte - 1) count++;
+    }
+    return count;
+}
+
+#endif
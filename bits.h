@@ -0,0 +1,51 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+#ifndef bits_h
+#define bits_h
+
+#include <stdint.h>
+
+/* Bit primitives on bitboards.
+ *
+ * lsb is the square of the lowest set bit, pop_lsb also clears it, popcount
+ * counts the set bits and for_each_bit visits each set square, so a loop costs
+ * one pass per piece rather than one per square. lsb and pop_lsb of an empty
+ * set are undefined.
+ *
+ * The host uses the compiler builtins, single instructions there. The AVR has
+ * no such instructions and libgcc walks 64-bit words bit by bit, so bits.c
+ * skips the empty bytes and looks the lowest bit of the first other one up in
+ * a 256-entry flash table.
+ */
+
+#ifdef __AVR__
+uint8_t lsb(uint64_t b);
+uint8_t popcount(uint64_t b);
+#else
+static inline uint8_t lsb(uint64_t b) {
+    return __builtin_ctzll(b);
+}
+
+static inline uint8_t popcount(uint64_t b) {
+    return __builtin_popcountll(b);
+}
+#endif
+
+static inline uint8_t pop_lsb(uint64_t* b) {
+    uint8_t sq = lsb(*b);
+    *b &= *b - 1;
+    return sq;
+}
+
+// Runs the statement after it with sq set to each square in set, lowest first
+// (set is evaluated once, sq is a uint8_t declared by the loop so that / and %
+// by BOARD_SIZE stay byte operations; break and continue work as in a for)
+#define for_each_bit(sq, set) \
+    for (uint64_t sq##_left = (set); sq##_left; sq##_left = 0) \
+        for (uint8_t sq##_go = 1; sq##_go && sq##_left; ) \
+            for (uint8_t sq = (sq##_go = 0, pop_lsb(&sq##_left)); !sq##_go; sq##_go = 1)
+
+#endif
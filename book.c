@@ -0,0 +1,80 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+#include <stdint.h>
+#include "chess_core.h"
+#include "progmem.h"
+#include "book.h"
+#include "book_data.h"
+
+/* Mixes one more word into a key (one multiply a word, so it stays cheap on the device) */
+static uint64_t mix(uint64_t key, uint64_t word) {
+    key = (key ^ word) * 0x9E3779B97F4A7C15;
+    return key ^ (key >> 29);
+}
+
+/* Book key of the current position. En passant is left out: books rarely
+ * tell those positions apart, and a wrong capture is caught by the legality
+ * check in book_move. */
+uint64_t book_key() {
+
+    uint64_t key = 0;
+
+    for (uint8_t type = W_PAWN; type <= B_KING; type++) {
+        key = mix(key, bitboards[type]);
+    }
+
+    return mix(key, ((uint64_t) castle_flags << 1) | current_player);
+}
+
+/* A book move for the current position, picked among the entries for it in
+ * proportion to their weights by a random number. NULL_MOVE if the position is
+ * not in the book. */
+uint16_t book_move(uint16_t random) {
+
+    uint64_t key = book_key();
+    uint16_t low = 0;
+    uint16_t high = BOOK_ENTRIES;
+
+    // First entry whose key is not below the position's
+    while (low < high) {
+        uint16_t mid = (low + high) / 2;
+        if (pgm_read_bitboard(&book[mid].key) < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    uint32_t total = 0;
+    for (high = low; high < BOOK_ENTRIES && pgm_read_bitboard(&book[high].key) == key; high++) {
+        total += pgm_read_word(&book[high].weight);
+    }
+
+    if (total == 0) return NULL_MOVE;
+
+    // Walk the weights up to the random point
+    uint32_t point = (uint32_t) random * total >> 16;
+    for (; low < high; low++) {
+        uint16_t weight = pgm_read_word(&book[low].weight);
+        if (point < weight) break;
+        point -= weight;
+    }
+
+    // Another position with the same key would give a move that is not legal here
+    uint16_t move = pgm_read_word(&book[low].move);
+    move_list list;
+    generate_legal(&list);
+    for (uint8_t i = 0; i < list.count; i++) {
+        if (list.moves[i] == move) return move;
+    }
+
+    return NULL_MOVE;
+}
+
+/* Entries in the book */
+uint16_t book_entries() {
+    return BOOK_ENTRIES;
+}
@@ -0,0 +1,35 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+#ifndef book_h
+#define book_h
+
+#include <stdint.h>
+
+/* Opening book.
+ *
+ * A table of (position, move, weight) entries in flash (book_data.h), sorted
+ * by position key so a probe is a binary search. The key is worked out here
+ * from the bitboards, the castling rights and the side to move, apart from the
+ * Zobrist hash, so a book stays valid whatever the search's keys are.
+ *
+ * book_data.h is written by the host tool host/book.c from PGN games
+ * (make book, see the README).
+ */
+
+typedef struct {
+    uint64_t key;                       // book_key() of the position
+    uint16_t move;
+    uint16_t weight;                    // Games that played the move
+} book_entry;
+
+// Flash an entry takes on the device (the host pads them to 16 bytes)
+#define BOOK_ENTRY_BYTES 12
+
+uint64_t book_key();
+uint16_t book_move(uint16_t random);
+uint16_t book_entries();
+
+#endif
@@ -0,0 +1,568 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+/* Opening book (see book.h), written by host/book.c: 43 games, 16 plies each,
+ * 547 entries in 6564 bytes of flash. */
+
+#ifndef book_data_h
+#define book_data_h
+
+#include <stdint.h>
+#include "progmem.h"
+#include "book.h"
+
+#define BOOK_ENTRIES 547
+
+static const book_entry book[BOOK_ENTRIES] PROGMEM = {
+    { 0x0045CBFFB94B277F, 0x067D,     1 },
+    { 0x00B2EDA41F90FC36, 0x46E2,     1 },
+    { 0x00CA864129F4C4CE, 0x045B,     1 },
+    { 0x00F1950CC0E96A50, 0x0408,     1 },
+    { 0x017ABDB339BA2DA1, 0x0F3B,     1 },
+    { 0x02343C1FE457288C, 0x4AA1,     1 },
+    { 0x035229E038E178E6, 0x4A9B,     1 },
+    { 0x03A6B17E9F36A2D0, 0x0D3B,     1 },
+    { 0x041C8594B02EF952, 0x0BB6,     1 },
+    { 0x04A5D11D0ADE0FD4, 0x4723,     1 },
+    { 0x0556C0381ED3DACB, 0x0CF9,     1 },
+    { 0x0684209107F4FB0E, 0x0546,     1 },
+    { 0x06ACFC00D1BB336F, 0x082A,     1 },
+    { 0x07436AE3B7D37AE2, 0x4AB3,     1 },
+    { 0x0777B02C3C5F1D57, 0x059D,     1 },
+    { 0x07D49BB5E9E4CEB0, 0x4693,     1 },
+    { 0x0A1198ED6CD162EE, 0x19B6,     1 },
+    { 0x0B58D09BFDD1BD93, 0x4723,     1 },
+    { 0x0BAA9E2CF7EF7DD1, 0x0DBD,     1 },
+    { 0x0BC1CAF7AD7EB747, 0x0481,     1 },
+    { 0x0BC1CAF7AD7EB747, 0x0685,     2 },
+    { 0x0BC1CAF7AD7EB747, 0x0845,     3 },
+    { 0x0BC1CAF7AD7EB747, 0x16CB,     1 },
+    { 0x0C45C9CDC7FF7077, 0x0DBD,     1 },
+    { 0x0D41664F26182C1F, 0x4489,     1 },
+    { 0x0F2540358A6D25DC, 0x09C3,     1 },
+    { 0x0F42841AF45F910F, 0x0458,     1 },
+    { 0x0F58521EBF4286F1, 0x08EB,     1 },
+    { 0x0F9CA6FCDE53A1EA, 0x02C3,     1 },
+    { 0x10D4D64058A38DE4, 0x045A,     1 },
+    { 0x1127A03B59F8EA75, 0x058E,     1 },
+    { 0x11870E64BCDECE6D, 0x16CB,     1 },
+    { 0x118BF9246B2C2798, 0x067D,     1 },
+    { 0x118D7D9B15DA11ED, 0x2FBC,     1 },
+    { 0x11DABA145CCAFA68, 0x0306,     1 },
+    { 0x121DDBBF8C0FC41B, 0x0DBD,     1 },
+    { 0x1246E26BD0AC3C79, 0x097A,     1 },
+    { 0x12D7C7F116455369, 0x048A,     1 },
+    { 0x12D7C7F116455369, 0x0546,     6 },
+    { 0x12E29A1805DD65A8, 0x0AB9,     1 },
+    { 0x1390DAB996E027ED, 0x4EFC,     1 },
+    { 0x13D60A96ABE3EFFC, 0x48ED,     1 },
+    { 0x1478F49557D9E1AC, 0x18F3,     1 },
+    { 0x14E32A3E5F5609F1, 0x4915,     1 },
+    { 0x152AA9B8E74B6EB7, 0x472D,     1 },
+    { 0x15A6B990F02D6F2C, 0x0DBD,     2 },
+    { 0x15A6B990F02D6F2C, 0x18F3,     1 },
+    { 0x16747F35A4A94AA9, 0x1830,     1 },
+    { 0x18A2638B51535B0D, 0x4685,     1 },
+    { 0x18D12BB32F1D67C6, 0x0AB9,     1 },
+    { 0x18F17812E5FFE742, 0x0481,     1 },
+    { 0x19092097646EDE98, 0x0546,     1 },
+    { 0x19972F443745D70F, 0x0DBD,     1 },
+    { 0x19A8DC746420733C, 0x4489,     1 },
+    { 0x19B09F98C2BA5B42, 0x48DA,     1 },
+    { 0x1A6FBFE72A4773E1, 0x0105,     1 },
+    { 0x1A767F3CB153B3D4, 0x0546,     1 },
+    { 0x1AC92D8AA5A5F8AC, 0x4AA1,     1 },
+    { 0x1B26958803EEA81A, 0x097A,     1 },
+    { 0x1B6D6ED8B9CD5C78, 0x0481,     1 },
+    { 0x1B6D6ED8B9CD5C78, 0x0546,     8 },
+    { 0x1B6D6ED8B9CD5C78, 0x174D,     1 },
+    { 0x1CD64661988FD323, 0x0408,     1 },
+    { 0x1DFDF37C549C7661, 0x0D3D,     1 },
+    { 0x1E287F1F7E26E189, 0x0B34,     1 },
+    { 0x1F195E6E98B0AB1C, 0x46D5,     1 },
+    { 0x1F33360836C021C3, 0x1871,     1 },
+    { 0x2034DE14CE8C0ACD, 0x0B7E,     1 },
+    { 0x2090CA69700D26BC, 0x0B7E,     1 },
+    { 0x20E15FF1E4B1CBD1, 0x2FBC,     1 },
+    { 0x211DCE4875953BA8, 0x08DB,     1 },
+    { 0x21CD087672787CB2, 0x1975,     1 },
+    { 0x22232744579CEC8B, 0x0B7E,     1 },
+    { 0x225BF92D03EA4AD1, 0x04C5,     1 },
+    { 0x22F3875F8FF5EBD3, 0x4AB1,     1 },
+    { 0x241F6140A76DE383, 0x067D,     2 },
+    { 0x244B9E1C67E61027, 0x46D5,     1 },
+    { 0x2516E88BB241A0CA, 0x0B7E,     1 },
+    { 0x259696A7DDEF8B7C, 0x0AB2,     1 },
+    { 0x264A7C6496B2040E, 0x16CB,     1 },
+    { 0x2653B65A9424D1DA, 0x0AB9,     2 },
+    { 0x2653B65A9424D1DA, 0x0AF3,     3 },
+    { 0x2653B65A9424D1DA, 0x0B34,     1 },
+    { 0x2739429120C9B719, 0x050C,     1 },
+    { 0x288F3B30124C489D, 0x06A2,     1 },
+    { 0x28C8F2135F84765E, 0x091C,     1 },
+    { 0x28F6099E57FB8B59, 0x2FBC,     1 },
+    { 0x295CAF9D96B6AB67, 0x18F3,     1 },
+    { 0x2A0B52BAC707BAE8, 0x0B34,     1 },
+    { 0x2B5A10D430437FF2, 0x491B,     1 },
+    { 0x2CBBD1E97F670718, 0x0105,     1 },
+    { 0x2CD93F2B12FAE7C5, 0x0AB9,     1 },
+    { 0x2CE03E5EBA296258, 0x0DEE,     1 },
+    { 0x2D5B7CC569F8CB0A, 0x0481,     2 },
+    { 0x2DB61C306E9B799F, 0x0D3D,     1 },
+    { 0x2E558CA1BFB98B70, 0x0B7E,     2 },
+    { 0x2EA270BDFAF19C76, 0x0449,     1 },
+    { 0x2F0129B834D95A10, 0x2184,     1 },
+    { 0x2F7C04DDCD63C9CF, 0x02C1,     1 },
+    { 0x2F7C04DDCD63C9CF, 0x0481,     1 },
+    { 0x2F7C04DDCD63C9CF, 0x091C,     1 },
+    { 0x302D1B133D4CA410, 0x0A63,     1 },
+    { 0x30A22AC0C2981C14, 0x0ADC,     1 },
+    { 0x3173D260D18FEDE1, 0x0A71,     1 },
+    { 0x317BB960F3002AB6, 0x0408,     1 },
+    { 0x31DE11C6CEF70A81, 0x0481,     3 },
+    { 0x32110933B1040930, 0x1975,     1 },
+    { 0x321D56E58964D9FF, 0x0546,     1 },
+    { 0x323BC9CA57145800, 0x168A,     1 },
+    { 0x32F3DFEAE7D677AF, 0x0385,     1 },
+    { 0x347C6FB7191B4040, 0x0AB2,     1 },
+    { 0x348B4648F895317A, 0x0546,     2 },
+    { 0x35E84EE17F7B1C44, 0x04C5,     1 },
+    { 0x3609F6711E2419DE, 0x48FB,     1 },
+    { 0x365DCA60DBF338CC, 0x048A,     1 },
+    { 0x3679AB085D345A62, 0x0AF3,     2 },
+    { 0x36B30F27D6607349, 0x0481,     1 },
+    { 0x37EF43B1A659DC83, 0x0385,     1 },
+    { 0x37F351DDF9A08694, 0x0385,     1 },
+    { 0x381255B9AD26CB49, 0x2184,     1 },
+    { 0x3816BE32871B7F9E, 0x0CBB,     1 },
+    { 0x381EB5CEAB8DCAD0, 0x08D2,     1 },
+    { 0x38CCCFDCD2A8848F, 0x0D3D,     1 },
+    { 0x390CF2CABF0B3A97, 0x0305,     1 },
+    { 0x39153C9AE3325C24, 0x07BA,     1 },
+    { 0x393B7A7E7162F095, 0x04CB,     1 },
+    { 0x3954B567CAEA8F62, 0x0543,     1 },
+    { 0x3AF8F685312E5872, 0x0305,     1 },
+    { 0x3C60FD8C8F01F112, 0x4499,     1 },
+    { 0x3C67E4024BB3CFAB, 0x0546,     1 },
+    { 0x3EADF772E5546577, 0x170C,     1 },
+    { 0x409F750A26C2DDC5, 0x4AB3,     1 },
+    { 0x414865F4BEABEA35, 0x170C,     2 },
+    { 0x419B5D1BF5DD5E23, 0x067D,     1 },
+    { 0x41C73FA7CCE5F433, 0x2184,     1 },
+    { 0x4249F7DB96807780, 0x489B,     1 },
+    { 0x428CFC5D17D4CB7D, 0x0DBD,     1 },
+    { 0x42F91AC9BCE3B971, 0x0564,     1 },
+    { 0x43EF550FEDF29BAF, 0x04DA,     1 },
+    { 0x4459EA32F21B3BCE, 0x02C2,     1 },
+    { 0x448DFC0CD682C5DB, 0x0283,     1 },
+    { 0x44CEEEA9DB83A561, 0x0AF3,     1 },
+    { 0x44EB2149869E81B2, 0x2FBC,     1 },
+    { 0x45DDF2554255F571, 0x082A,     1 },
+    { 0x45F591EA90BB33F8, 0x02C2,     1 },
+    { 0x46A29DE31905F3B9, 0x0546,     1 },
+    { 0x46A63CF23CA93685, 0x2FBC,     1 },
+    { 0x4748B45F73A25311, 0x2FBC,     1 },
+    { 0x48878EAF1285E480, 0x18F3,     3 },
+    { 0x48F6A05281092056, 0x02C1,     1 },
+    { 0x49BB30BE38FAED99, 0x0481,     3 },
+    { 0x49C228943E4BBE02, 0x085A,     1 },
+    { 0x4A025EFD72EAB331, 0x0A30,     1 },
+    { 0x4A73395EBFAF1D9D, 0x0BB6,     1 },
+    { 0x4B75A6E68F23C71C, 0x0B34,     1 },
+    { 0x4BFBBBC226ACC2D7, 0x07E6,     1 },
+    { 0x4C4D3FBBC1AFE226, 0x18F3,     1 },
+    { 0x4C4DEED4A31FC432, 0x0305,     1 },
+    { 0x4C63D0536EA1E6A1, 0x0D3D,     1 },
+    { 0x4CB01F7F2BEC1E61, 0x0BF7,     1 },
+    { 0x4CD2E790079EC200, 0x48EC,     1 },
+    { 0x4CD5F553A3B95E44, 0x48DC,     1 },
+    { 0x4D8816B5BF33AEBC, 0x0D3D,     1 },
+    { 0x4DEE711443740B6A, 0x48ED,     1 },
+    { 0x4E8743F506E876E5, 0x048A,     1 },
+    { 0x4EE1C896CC973808, 0x04C5,     1 },
+    { 0x4FE0FA7ABD8A94E2, 0x46E2,     1 },
+    { 0x5016106D310AA978, 0x02C1,     1 },
+    { 0x5040672CE8FBDCE8, 0x16CB,     1 },
+    { 0x51B7266E8BBDC53B, 0x46A3,     1 },
+    { 0x5201F56855FC6179, 0x0B7E,     1 },
+    { 0x52FD2884F9667947, 0x4EC3,     1 },
+    { 0x530AA1BC58AED2ED, 0x2184,     1 },
+    { 0x53317E5438515BF8, 0x0982,     1 },
+    { 0x5342A340653F70D4, 0x045B,     1 },
+    { 0x54AF3644FD402333, 0x2FBC,     1 },
+    { 0x54C0B9D7D50DF174, 0x08AA,     1 },
+    { 0x550950A21B7CF9B1, 0x048A,     1 },
+    { 0x5596F74EFC15ED1D, 0x4AB3,     1 },
+    { 0x55DB10B7CEDD7788, 0x08BD,     1 },
+    { 0x55DB10B7CEDD7788, 0x0B7E,     1 },
+    { 0x565BC414AD415175, 0x0B7E,     1 },
+    { 0x5700EAAF562D9895, 0x0B34,     1 },
+    { 0x5700EAAF562D9895, 0x46A3,     1 },
+    { 0x570CBC0CCA5BC3A4, 0x058E,     1 },
+    { 0x57A3C3BE0A7F2794, 0x0685,     1 },
+    { 0x58BF844382F06045, 0x0AB9,     1 },
+    { 0x58C42A9DEFAEA816, 0x16CB,     2 },
+    { 0x58E95E8796F90EB5, 0x0567,     1 },
+    { 0x59352CCF57A8C3CD, 0x0D3B,     1 },
+    { 0x5E250739A7959769, 0x0B3A,     1 },
+    { 0x5E8EF481ABAC1791, 0x0BB6,     1 },
+    { 0x5EB3908708EB8FD9, 0x4499,     1 },
+    { 0x5EF96F0F9F427771, 0x40FB,     1 },
+    { 0x5FD62E5EA24936DF, 0x2FBC,     1 },
+    { 0x6004B174F87D3CBE, 0x067D,     1 },
+    { 0x606AD82AE672E708, 0x0B34,     1 },
+    { 0x60CD1BBB90F9A625, 0x2184,     1 },
+    { 0x619CCBE55D9F189B, 0x02C2,     1 },
+    { 0x61C9C4EA7A6DE4A8, 0x0AB2,     1 },
+    { 0x6423572DFB226EF2, 0x0B34,     1 },
+    { 0x645914EC63B76760, 0x46A3,     1 },
+    { 0x64764410FAB8076D, 0x1871,     1 },
+    { 0x649B43CC9E9696D9, 0x0502,     1 },
+    { 0x64F3A154E0046552, 0x0C22,     1 },
+    { 0x64FE1ECD514C66AF, 0x08ED,     1 },
+    { 0x65565EE6B3E7F255, 0x472D,     1 },
+    { 0x66231CD4CF30964B, 0x0D3D,     1 },
+    { 0x6709A23599306872, 0x2184,     1 },
+    { 0x67775F1B8F8D22C0, 0x0915,     1 },
+    { 0x67CA17E42249B272, 0x17CF,     1 },
+    { 0x6907694B0660540E, 0x07A6,     1 },
+    { 0x691658D3F612993A, 0x0B34,     1 },
+    { 0x6992555272035691, 0x050C,     1 },
+    { 0x6A1874A4C8AEE16C, 0x0AB9,     1 },
+    { 0x6A7180070AB76E30, 0x097A,     1 },
+    { 0x6AA72C48FC45CBB4, 0x2184,     1 },
+    { 0x6AE78BC1D603381A, 0x48EC,     1 },
+    { 0x6AF8DE7B55D45B52, 0x0AB9,     1 },
+    { 0x6B709461ABAAAC4F, 0x48DA,     1 },
+    { 0x6C25DABDB7294D14, 0x04C5,     1 },
+    { 0x6C4853C6E9B9A6DA, 0x04CB,     1 },
+    { 0x6C8FBC9B6AE747DD, 0x0546,     1 },
+    { 0x6C8FBC9B6AE747DD, 0x054D,     1 },
+    { 0x6CC74D57D88DB250, 0x04CB,     1 },
+    { 0x6DC31FF36E9A7975, 0x46A3,     1 },
+    { 0x6DDF58815DDBE620, 0x0982,     1 },
+    { 0x6DDF58815DDBE620, 0x48DA,     1 },
+    { 0x6DF1CEB5DC627F9D, 0x067D,     1 },
+    { 0x6EC9667B8FA648F4, 0x2184,     1 },
+    { 0x6EF04F14EB8DDFAD, 0x16CB,     3 },
+    { 0x6FDCCDDC8CA9FD72, 0x0D3E,     1 },
+    { 0x709074C79E980C7F, 0x46D5,     1 },
+    { 0x7095672EB64D4458, 0x4764,     1 },
+    { 0x70C425972BA4130C, 0x2FBC,     1 },
+    { 0x710A6C93D7F10F69, 0x0CF9,     1 },
+    { 0x71D57B83E7BEE25D, 0x0A30,     1 },
+    { 0x7242001FAF526731, 0x0B7E,     1 },
+    { 0x72C08D5BAE6D8E58, 0x44A3,     1 },
+    { 0x72E95681E088F075, 0x0AB9,     1 },
+    { 0x731C2B4A397C0EE1, 0x2184,     1 },
+    { 0x7410DD8C7EF5E3F4, 0x48DA,     1 },
+    { 0x748D2DEFB8A3F0EA, 0x04C5,     1 },
+    { 0x74B2CDB5B5139CB6, 0x1934,     1 },
+    { 0x74FC502B00EF6352, 0x0A63,     1 },
+    { 0x756470C8902F6D67, 0x16CB,     1 },
+    { 0x75C86B18453FE73D, 0x0502,     1 },
+    { 0x768544F5C03A51F8, 0x472D,     1 },
+    { 0x77E69EDE4F30E691, 0x0305,     1 },
+    { 0x78584FCC731E6862, 0x2184,     1 },
+    { 0x7865D7C98AD8F6C4, 0x0823,     1 },
+    { 0x793DA95777533823, 0x2FBC,     1 },
+    { 0x79816E5503BFCB65, 0x0AB9,     1 },
+    { 0x7A07D0ACD126D4E7, 0x2184,     1 },
+    { 0x7A2332654712F244, 0x0546,     1 },
+    { 0x7A31653BAB351A81, 0x40C5,     1 },
+    { 0x7B39C9A6ED34DA5D, 0x1608,     1 },
+    { 0x7B49E44A6C074709, 0x16CB,     1 },
+    { 0x7BAAAFEE340303A5, 0x0BB6,     1 },
+    { 0x7C15F24947916AED, 0x2FBC,     1 },
+    { 0x7C20DB9D86AC643F, 0x0A71,     1 },
+    { 0x7C647728A8DE6C49, 0x0D3D,     1 },
+    { 0x7D2368D3C444AA12, 0x0502,     1 },
+    { 0x7E5D162ECA2777BE, 0x2184,     1 },
+    { 0x7EA2C63996EB030E, 0x0A7B,     1 },
+    { 0x7F0221AA59740345, 0x0283,     1 },
+    { 0x7F048BA9B4CA58BB, 0x0283,     1 },
+    { 0x7F048BA9B4CA58BB, 0x050C,     1 },
+    { 0x7F0CF67D03D2C9EA, 0x0B7E,     1 },
+    { 0x7F6F6781B3772390, 0x2FBC,     1 },
+    { 0x7FF8778B5ECFC05F, 0x2FBC,     1 },
+    { 0x80185C7CF15C912D, 0x0303,     1 },
+    { 0x824066FD5A233503, 0x1934,     1 },
+    { 0x829096BE10C04048, 0x46A3,     1 },
+    { 0x82EAC6564984ECC2, 0x085A,     1 },
+    { 0x83EBF1DF32AF29ED, 0x0385,     1 },
+    { 0x8443196B2AD8D939, 0x045A,     1 },
+    { 0x849EA45D7899C11D, 0x066A,     1 },
+    { 0x84ED68007AE01BC7, 0x0D3E,     1 },
+    { 0x8532EE74D9D9F139, 0x18B2,     1 },
+    { 0x85FB3A244A668F82, 0x08DB,     1 },
+    { 0x8683AD51861CA122, 0x08AA,     1 },
+    { 0x8691C5C9B7F6C39E, 0x46E4,     1 },
+    { 0x869E9AB5D77FA6AE, 0x0B7E,     1 },
+    { 0x86CB3401319B982E, 0x04CB,     1 },
+    { 0x870831F30E317CBB, 0x46E2,     1 },
+    { 0x879C641AE8D8F549, 0x0481,     1 },
+    { 0x88001CD7343DA470, 0x46D2,     1 },
+    { 0x88D2F8D856DE81E3, 0x0AF3,     1 },
+    { 0x891193148BCF8030, 0x058E,     1 },
+    { 0x8990A5CFCC98597E, 0x4692,     1 },
+    { 0x89F08D274A7F5E7B, 0x16CB,     1 },
+    { 0x8BEF6CDB2773C1EC, 0x08ED,     1 },
+    { 0x8C17C6731E4F07FD, 0x050C,     1 },
+    { 0x8C3734A0121B9F5A, 0x2FBC,     1 },
+    { 0x8C5B791A89FB7CFD, 0x0D19,     1 },
+    { 0x8C61E2D79BC25A21, 0x0A71,     1 },
+    { 0x8EA4FD573929053E, 0x1934,     1 },
+    { 0x8F15A6C34CACDA05, 0x0C7A,     1 },
+    { 0x8FF84BBB177F5DA7, 0x0546,     1 },
+    { 0x8FF84BBB177F5DA7, 0x168A,     5 },
+    { 0x90CC7364518684E5, 0x0481,     1 },
+    { 0x90ED194526A83621, 0x0A3A,     1 },
+    { 0x9104EEBB38C643FB, 0x0481,     1 },
+    { 0x91B5F2C0F8817DA9, 0x08ED,     1 },
+    { 0x91C5DCD2031C8420, 0x2184,     1 },
+    { 0x92B2A125C5CC9953, 0x04C5,     1 },
+    { 0x92C1F76D7D9CF7E2, 0x0546,     1 },
+    { 0x93B56D8B78980B9E, 0x0DBD,     1 },
+    { 0x93CE799860DF0527, 0x0A3A,     1 },
+    { 0x96081C37DA463ED2, 0x02C1,     1 },
+    { 0x96E835BDA55F77D4, 0x0A71,     1 },
+    { 0x96E98B9986A3FAE5, 0x46E4,     1 },
+    { 0x970F6F52207FCF47, 0x0B34,     1 },
+    { 0x971FF48D7966E3D4, 0x0CF9,     1 },
+    { 0x97568D58D46058A1, 0x0AB9,     1 },
+    { 0x97937923C84279EF, 0x0AF3,     1 },
+    { 0x98EFB30634650CB6, 0x46E2,     1 },
+    { 0x998BBFCD3BB4AB54, 0x0546,     1 },
+    { 0x998BBFCD3BB4AB54, 0x168A,     2 },
+    { 0x998BBFCD3BB4AB54, 0x16CB,    15 },
+    { 0x998BBFCD3BB4AB54, 0x170C,    25 },
+    { 0x99D1929769249D28, 0x18F3,     2 },
+    { 0x9A25F137693FA6EA, 0x18B2,     1 },
+    { 0x9A760DB3CD523347, 0x0CF9,     1 },
+    { 0x9A8FCCF2761FA1B3, 0x0502,     1 },
+    { 0x9AB5E889CD641546, 0x04CB,     1 },
+    { 0x9AE9AEBFC1A44F04, 0x0AB9,     1 },
+    { 0x9B18E3AB1D168BC2, 0x0481,     1 },
+    { 0x9BEC697C0CD18523, 0x18B2,     1 },
+    { 0x9C138D437C8F9CD8, 0x4BF6,     1 },
+    { 0x9C602CBD1122F6B1, 0x0AF3,     1 },
+    { 0x9CE134618E8060DB, 0x048A,     1 },
+    { 0x9CEE93B4F5A8E4F5, 0x04E4,     1 },
+    { 0x9D01609DE884B948, 0x0408,     1 },
+    { 0x9D973F6EBD145777, 0x0AF3,     1 },
+    { 0x9E040D5F6DFB7F2B, 0x058E,     1 },
+    { 0x9F91665DBB093246, 0x0306,     1 },
+    { 0x9FB32ECCC5ED9BC8, 0x48ED,     1 },
+    { 0xA006D283BDB037B0, 0x18F3,     1 },
+    { 0xA027E1680CC90D53, 0x18B2,     1 },
+    { 0xA0559F6842CF74E8, 0x448A,     1 },
+    { 0xA1452177FCE11356, 0x0845,     1 },
+    { 0xA2061B7B541FB8D0, 0x0D3D,     1 },
+    { 0xA25EB793F8CE07F0, 0x0B7E,     1 },
+    { 0xA3059E9A58FF87FF, 0x4713,     1 },
+    { 0xA32010F8F33042FF, 0x0D3B,     1 },
+    { 0xA3E16E9A1ACBC2FE, 0x168A,     8 },
+    { 0xA474B4C63CFFA436, 0x0D3D,     1 },
+    { 0xA4CBFDFCF441560B, 0x0BB6,     1 },
+    { 0xA6D8F5C26FA5A396, 0x0B7E,     1 },
+    { 0xA7A62391633B0AC5, 0x0449,     1 },
+    { 0xA84CD4A8C679BCB3, 0x091C,     1 },
+    { 0xA84F6C63ACCD1146, 0x0546,     1 },
+    { 0xA85B7FCD4CF7A534, 0x0481,     1 },
+    { 0xA9CB1B30AC7A911E, 0x059C,     1 },
+    { 0xA9DFD2C2CD34E567, 0x02C3,     1 },
+    { 0xAAC4F6BFB33BFC0F, 0x0AB2,     1 },
+    { 0xAAD8A90BB285D627, 0x0982,     1 },
+    { 0xAAF7E5C3850279D9, 0x0B7E,     1 },
+    { 0xAC3D7BA6962845E9, 0x083B,     1 },
+    { 0xAC94D2A9B2C0E778, 0x0481,     2 },
+    { 0xAC94D2A9B2C0E778, 0x0546,     1 },
+    { 0xAC94D2A9B2C0E778, 0x058E,     1 },
+    { 0xAD12E1328A074A7E, 0x0AF3,     1 },
+    { 0xAD1A95C05D121C65, 0x058E,     1 },
+    { 0xAD2B5F0D0B0A33A2, 0x48BD,     1 },
+    { 0xAD40F807F86F3BDC, 0x050C,     1 },
+    { 0xAE508CCBAD68D123, 0x0481,     1 },
+    { 0xAEA142B7C1DA3159, 0x0AB9,     7 },
+    { 0xAEA142B7C1DA3159, 0x0B7E,     1 },
+    { 0xAEC59005871C2D3C, 0x050C,     1 },
+    { 0xAF24A1775DEDD1B8, 0x0982,     1 },
+    { 0xAF8B9D5F13A359F6, 0x0B7E,     1 },
+    { 0xB047336F832A367D, 0x4712,     1 },
+    { 0xB196ED4ACA01D47E, 0x097A,     1 },
+    { 0xB319A3946046E862, 0x0B7E,     1 },
+    { 0xB325F5D8EBCAB810, 0x0CF9,     1 },
+    { 0xB3C63EFBF5CBEE1A, 0x16CB,     3 },
+    { 0xB3EBE8FF98C0B855, 0x0546,     1 },
+    { 0xB418EE13BD40344A, 0x2FBC,     1 },
+    { 0xB4A295F626310189, 0x0A30,     2 },
+    { 0xB4A295F626310189, 0x0B7E,     1 },
+    { 0xB4C7C224CFD8C94A, 0x091C,     1 },
+    { 0xB4E5FAA3C01B3470, 0x054D,     1 },
+    { 0xB4FFE970C2C5CB62, 0x0502,     1 },
+    { 0xB5A2D7E88D495798, 0x0481,     2 },
+    { 0xB5D3904FA937EA70, 0x0685,     1 },
+    { 0xB6272F8AA7D131A4, 0x18B2,     1 },
+    { 0xB7D45A646F78017A, 0x09DF,     1 },
+    { 0xB7EFA1BA77581766, 0x091C,     1 },
+    { 0xB80630DE698FD07F, 0x2FBC,     1 },
+    { 0xB9F595C25B45EA41, 0x0A30,     1 },
+    { 0xBAB23216B75D9540, 0x48DA,     1 },
+    { 0xBAFE57B05F0A9FF2, 0x46E2,     3 },
+    { 0xBB0586CA598CED35, 0x0783,     1 },
+    { 0xBB15708E7CFC8075, 0x0B34,     4 },
+    { 0xBB15708E7CFC8075, 0x0BB6,     3 },
+    { 0xBB15708E7CFC8075, 0x18B2,     1 },
+    { 0xBBA979391315C0BE, 0x08D5,     1 },
+    { 0xBBE54E7874D048D8, 0x0D3D,     1 },
+    { 0xBC782FB665EE4781, 0x0B7E,     8 },
+    { 0xBC782FB665EE4781, 0x18F3,     6 },
+    { 0xBC782FB665EE4781, 0x1975,     1 },
+    { 0xBC9B6E0D78F95DF7, 0x0B7E,     1 },
+    { 0xBD025421E8326066, 0x048B,     1 },
+    { 0xBDA58288062C1A6C, 0x0AB9,     1 },
+    { 0xBDFF7B4C4685517D, 0x0A71,     1 },
+    { 0xBFA48D3C4C82C52B, 0x1871,     1 },
+    { 0xC087BDDE1A8D3042, 0x0AF3,     1 },
+    { 0xC0BE50164A657A3F, 0x2184,     1 },
+    { 0xC0CEDBFA0313B624, 0x2FBC,     1 },
+    { 0xC1C9F9AE122E13DE, 0x0B7E,     1 },
+    { 0xC2094A12274BAB72, 0x050C,     1 },
+    { 0xC47CC1AE04ACB691, 0x18F3,     1 },
+    { 0xC4D263BF2822A777, 0x0BA5,     1 },
+    { 0xC528E0B9D4FA63EF, 0x168A,     1 },
+    { 0xC58C04E34CA8E57D, 0x048A,     1 },
+    { 0xC5B1C07AA3488988, 0x0AB2,     2 },
+    { 0xC5B1C07AA3488988, 0x0B34,     2 },
+    { 0xC5B1C07AA3488988, 0x46A3,     1 },
+    { 0xC768B2C6E1628547, 0x0BF7,     1 },
+    { 0xC7E4D120554CD4B6, 0x4742,     1 },
+    { 0xC80E32C32035BD3C, 0x0B75,     1 },
+    { 0xC84DA08075F7CF65, 0x46D2,     1 },
+    { 0xC97258412A5111C9, 0x0481,     1 },
+    { 0xCB6413391E4671BC, 0x0BD4,     1 },
+    { 0xCB8266C0B59F76D5, 0x0105,     1 },
+    { 0xCB9B4FA3EFD3DD93, 0x46D5,     3 },
+    { 0xCC50BA706E9EC3B0, 0x0B34,     1 },
+    { 0xCCFF1627E19A1416, 0x0ADC,     1 },
+    { 0xCD7B53604264CF47, 0x0AFD,     1 },
+    { 0xCE764A36BFBE2088, 0x3084,     1 },
+    { 0xCEC9DA10A4C8DE0D, 0x1871,     1 },
+    { 0xCFD417C9C30C56AC, 0x048A,     1 },
+    { 0xD00D86CB07AB0B12, 0x02C3,     1 },
+    { 0xD0A1643BB74F5F66, 0x0502,     1 },
+    { 0xD1EE317882512FC7, 0x0B7E,     3 },
+    { 0xD26EDC5157CD37BE, 0x0546,     1 },
+    { 0xD374ACAD33D0A1D1, 0x0CFA,     1 },
+    { 0xD3DD8176CFB50C33, 0x0742,     1 },
+    { 0xD3FF945889469CAF, 0x0B34,     1 },
+    { 0xD49A96799A80BC65, 0x0385,     1 },
+    { 0xD4EE5F3AED42316E, 0x04CB,     1 },
+    { 0xD6170DF566AC2C48, 0x174D,     1 },
+    { 0xD736E8F54022353E, 0x09ED,     1 },
+    { 0xD783C9BFC1B1B896, 0x0502,     1 },
+    { 0xD783C9BFC1B1B896, 0x0982,     1 },
+    { 0xD940794D6BE49055, 0x02C3,     1 },
+    { 0xD97065F4B2F34D0D, 0x0546,     1 },
+    { 0xD975BA6D53EDCA50, 0x0D3D,     1 },
+    { 0xD9887CF69BEEDACE, 0x04C5,     1 },
+    { 0xDB1239CFCAFEC49F, 0x0AB2,     2 },
+    { 0xDB1239CFCAFEC49F, 0x0AF3,     1 },
+    { 0xDB1239CFCAFEC49F, 0x0B34,     3 },
+    { 0xDB1239CFCAFEC49F, 0x0B7E,     1 },
+    { 0xDB1239CFCAFEC49F, 0x18B2,     7 },
+    { 0xDB1239CFCAFEC49F, 0x18F3,     1 },
+    { 0xDB1239CFCAFEC49F, 0x1934,    10 },
+    { 0xDB5A408BB3B124C4, 0x472D,     1 },
+    { 0xDBB94A44A7F0948E, 0x0AB9,     1 },
+    { 0xDC31B094B78E10E6, 0x18F3,     1 },
+    { 0xDC573D4D2E811ADE, 0x0385,     1 },
+    { 0xDC6E43A3A9E785F0, 0x4489,     1 },
+    { 0xDC6E92D0ECD8B0E0, 0x16CB,     1 },
+    { 0xDD423D21DDD444BE, 0x2184,     1 },
+    { 0xDD815A6983EA0B8B, 0x2184,     1 },
+    { 0xDDF5DF7AEBE7106A, 0x085B,     1 },
+    { 0xDE084F0F46BEECE3, 0x2FBC,     1 },
+    { 0xDE54DA7BF144F6A7, 0x40FB,     1 },
+    { 0xDE9CC19E43885FD0, 0x170C,     1 },
+    { 0xDF931473C1162B8C, 0x0A30,     1 },
+    { 0xE06FC9BD854E37B2, 0x091C,     1 },
+    { 0xE0822233529D751C, 0x0AB9,     1 },
+    { 0xE189176C0F5BCBB9, 0x0B7E,     2 },
+    { 0xE1ACDA13EE102376, 0x0852,     1 },
+    { 0xE1F59884C1D7B552, 0x18F3,     1 },
+    { 0xE25DA5C9B832062F, 0x0546,     1 },
+    { 0xE27658C75265A109, 0x0AB2,     1 },
+    { 0xE2A3DF78D99DC28E, 0x0685,     1 },
+    { 0xE3D580765C745363, 0x0B34,     1 },
+    { 0xE473FCD9DEE76412, 0x2184,     1 },
+    { 0xE49F86BD42BFCB6C, 0x0A30,     1 },
+    { 0xE5B5954004BADD80, 0x4499,     1 },
+    { 0xE66287276BB38393, 0x0A63,     1 },
+    { 0xE69897653089CD2C, 0x1934,     1 },
+    { 0xE6B54EBC45E1F861, 0x054D,     1 },
+    { 0xE6C9860DC7C8F04E, 0x0CF9,     1 },
+    { 0xE6E15D8AF8AFCCC2, 0x0546,     1 },
+    { 0xE746D6CEB65A62FD, 0x0AF3,     1 },
+    { 0xE763CBE2B65131B5, 0x0621,     1 },
+    { 0xE763CBE2B65131B5, 0x4AA1,     1 },
+    { 0xE78486BF5B732514, 0x04CB,     1 },
+    { 0xE80281CE969F5A4A, 0x0D2A,     1 },
+    { 0xE82297B6AC7DB2A0, 0x0481,     1 },
+    { 0xE82297B6AC7DB2A0, 0x091C,     1 },
+    { 0xE8538F539C80E827, 0x0546,     1 },
+    { 0xE8FB8C23ED60D5EB, 0x0AF3,     1 },
+    { 0xE9366AC20224D26F, 0x16CB,     1 },
+    { 0xE97D5947C19EBE6C, 0x0305,     1 },
+    { 0xE98B80318C123A08, 0x0D3E,     1 },
+    { 0xE9C364420F924D44, 0x18B2,     1 },
+    { 0xEA49924F475310E4, 0x0DBD,     1 },
+    { 0xEB0E33ABEA3F885C, 0x05CF,     1 },
+    { 0xEB12FBBAAA46C1DF, 0x168A,     1 },
+    { 0xEB935CB04456031D, 0x1934,     1 },
+    { 0xEC24BA2F45632A2C, 0x0AF3,     1 },
+    { 0xEC82D1C42FC64A2E, 0x0CED,     1 },
+    { 0xED62CC66A896DB21, 0x0A30,     1 },
+    { 0xED8D630BED0CCFBF, 0x08DB,     1 },
+    { 0xEEA5E2FA3D52185C, 0x16CB,     1 },
+    { 0xEFE366C30DF98DC3, 0x2FBC,     1 },
+    { 0xF00A3AD1C688583A, 0x168A,     1 },
+    { 0xF0147FF8FBB2AA12, 0x46D5,     1 },
+    { 0xF090DA39A6A0EBD4, 0x2184,     1 },
+    { 0xF0D34AC2E4BDFEB3, 0x170C,     1 },
+    { 0xF0E1FFEA0E0A6CB2, 0x0546,     1 },
+    { 0xF0F54CE3C4DB1052, 0x0A30,     2 },
+    { 0xF0F54CE3C4DB1052, 0x0BB6,     1 },
+    { 0xF1224A5D20D86AC5, 0x054D,     1 },
+    { 0xF131F98E4C008F87, 0x0AF3,     1 },
+    { 0xF147CCBBC6114D26, 0x096B,     1 },
+    { 0xF16E8B04446CE5F9, 0x0502,     1 },
+    { 0xF1F1AA103920EBDB, 0x468A,     1 },
+    { 0xF24E56373936C14B, 0x0EE0,     1 },
+    { 0xF25234C8A4CAE57E, 0x492B,     1 },
+    { 0xF2BA324C656580BE, 0x1871,     1 },
+    { 0xF2DF0C79CD78F39F, 0x4685,     1 },
+    { 0xF35FE72C91D23EF1, 0x0481,     1 },
+    { 0xF4D734362B3575C8, 0x4499,     1 },
+    { 0xF5771E17A462ADE9, 0x0421,     1 },
+    { 0xF73A9614CDD28A17, 0x0845,     1 },
+    { 0xF73A9614CDD28A17, 0x16CB,     1 },
+    { 0xF7944010E47F1C63, 0x18B2,     1 },
+    { 0xF7944010E47F1C63, 0x1934,     1 },
+    { 0xF947E4FD1863383E, 0x0D3D,     1 },
+    { 0xF960E03A253635AF, 0x2FBC,     1 },
+    { 0xF97B5FE6C84AB331, 0x0B75,     1 },
+    { 0xFA59056A1C5B4A4E, 0x0B7E,     1 },
+    { 0xFB5A0BDB1A5B5816, 0x2FBC,     1 },
+    { 0xFC3929E742584106, 0x18B2,     1 },
+    { 0xFC4D502547FD5728, 0x168A,     1 },
+    { 0xFC722138B0D6C47B, 0x0B7E,     1 },
+    { 0xFD50824B23E2808B, 0x0546,     1 },
+    { 0xFDE14AFCF6E0FA05, 0x17CF,     1 },
+    { 0xFF6054A2B8E3BA47, 0x0CBB,     1 },
+    { 0xFF69CA03AACE6272, 0x07BA,     1 }
+};
+
+#endif
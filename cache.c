@@ -0,0 +1,174 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+#include <stdint.h>
+#include "cache.h"
+
+#ifndef __AVR__
+#include <stdlib.h>
+#include <string.h>
+#endif
+
+// What an entry holds: perft counts use their depth (always 2 or more)
+#define CACHE_EMPTY 0
+#define CACHE_MOVES 1
+
+// Part of the key kept to confirm a hit. The device keeps the upper half and
+// leaves the lower half to pick the bucket, the host keeps all of it.
+#ifdef __AVR__
+typedef uint32_t cache_check;
+#else
+typedef uint64_t cache_check;
+#endif
+
+typedef struct {
+    cache_check check;
+    uint64_t value;
+    uint8_t depth;
+} cache_entry;
+
+typedef struct {
+    cache_entry deepest;                // Replaced only by a result at least as deep
+    cache_entry newest;                 // Always replaced
+} cache_bucket;
+
+#ifdef __AVR__
+
+// Set by the Makefile from a first link without the cache
+#ifndef CACHE_BYTES
+#define CACHE_BYTES 0
+#endif
+
+#define CACHE_BUCKETS ((CACHE_BYTES / sizeof(cache_bucket)) > 0 ? (CACHE_BYTES / sizeof(cache_bucket)) : 1)
+
+static cache_bucket cache[CACHE_BUCKETS];
+
+#else
+
+static cache_bucket* cache = 0;
+static uint32_t cache_buckets = 0;
+
+/* Allocates a cache of the given size (0 turns it off). Returns 0 if out of memory. */
+uint8_t cache_init(uint32_t megabytes) {
+
+    free(cache);
+    cache = 0;
+    cache_buckets = 0;
+
+    if (megabytes == 0) return 1;
+
+    uint32_t buckets = (uint64_t) megabytes * 1024 * 1024 / sizeof(cache_bucket);
+    cache = calloc(buckets, sizeof(cache_bucket));
+    if (!cache) return 0;
+
+    cache_buckets = buckets;
+    return 1;
+}
+
+#endif
+
+/* Empties the cache */
+void cache_clear() {
+#ifdef __AVR__
+    for (uint16_t i = 0; i < CACHE_BUCKETS; i++) {
+        cache[i].deepest.depth = CACHE_EMPTY;
+        cache[i].newest.depth = CACHE_EMPTY;
+    }
+#else
+    memset(cache, 0, cache_buckets * sizeof(cache_bucket));
+#endif
+}
+
+/* Number of results the cache can hold */
+uint32_t cache_entries() {
+#ifdef __AVR__
+    return 2 * CACHE_BUCKETS;
+#else
+    return 2 * cache_buckets;
+#endif
+}
+
+/* Bucket a key belongs to: the low key bits scaled onto the table (no division) */
+static cache_bucket* bucket_of(uint64_t key) {
+#ifdef __AVR__
+    return &cache[((uint32_t) (uint16_t) key * CACHE_BUCKETS) >> 16];
+#else
+    return &cache[((uint64_t) (uint32_t) key * cache_buckets) >> 32];
+#endif
+}
+
+static cache_check check_of(uint64_t key) {
+#ifdef __AVR__
+    return key >> 32;
+#else
+    return key;
+#endif
+}
+
+static uint8_t probe(uint64_t key, uint8_t depth, uint64_t* value) {
+
+#ifndef __AVR__
+    if (!cache_buckets) return 0;
+#endif
+
+    cache_bucket* b = bucket_of(key);
+    cache_check check = check_of(key);
+
+    if (b->deepest.depth == depth && b->deepest.check == check) {
+        *value = b->deepest.value;
+        return 1;
+    }
+    if (b->newest.depth == depth && b->newest.check == check) {
+        *value = b->newest.value;
+        return 1;
+    }
+    return 0;
+}
+
+static void store(uint64_t key, uint8_t depth, uint64_t value) {
+
+#ifndef __AVR__
+    if (!cache_buckets) return;
+#endif
+
+    cache_bucket* b = bucket_of(key);
+    cache_entry e = { check_of(key), value, depth };
+
+    if (b->deepest.depth == depth && b->deepest.check == e.check) {
+        b->deepest = e;
+    } else if (depth >= b->deepest.depth) {
+        // The old deepest result gets one more round in the other slot
+        b->newest = b->deepest;
+        b->deepest = e;
+    } else {
+        b->newest = e;
+    }
+}
+
+/* Perft subtree counts */
+
+uint8_t cache_probe_perft(uint64_t key, uint8_t depth, uint64_t* nodes) {
+    return probe(key, depth, nodes);
+}
+
+void cache_store_perft(uint64_t key, uint8_t depth, uint64_t nodes) {
+    if (depth > CACHE_MOVES) store(key, depth, nodes);
+}
+
+/* Legal destinations of one square. The square is folded into the key so each
+ * square of a position lands in its own bucket.
+ */
+
+static uint64_t square_key(uint64_t key, uint8_t square) {
+    return key ^ ((square + 1) * 0x9E3779B97F4A7C15);
+}
+
+uint8_t cache_probe_moves(uint64_t key, uint8_t square, uint64_t* moves) {
+    return probe(square_key(key, square), CACHE_MOVES, moves);
+}
+
+void cache_store_moves(uint64_t key, uint8_t square, uint64_t moves) {
+    store(square_key(key, square), CACHE_MOVES, moves);
+}
@@ -0,0 +1,38 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+#ifndef cache_h
+#define cache_h
+
+#include <stdint.h>
+
+/* Position-keyed result cache.
+ *
+ * Holds perft subtree counts (keyed by position and depth) and the legal
+ * destination set of single squares (keyed by position and square), both
+ * under the Zobrist key of the position (hash_key).
+ *
+ * Buckets hold two entries: one kept for the deepest result seen, one always
+ * replaced, so a tiny table still keeps its most expensive results while
+ * cheap ones churn through the other slot.
+ *
+ * On the device the table is a static array filling the SRAM left over by the
+ * globals and a stack reserve, sized by the Makefile (CACHE_BYTES). On the host
+ * it is allocated by cache_init() and the cache is off until then.
+ */
+
+#ifndef __AVR__
+uint8_t cache_init(uint32_t megabytes);
+#endif
+void cache_clear();
+uint32_t cache_entries();
+
+uint8_t cache_probe_perft(uint64_t key, uint8_t depth, uint64_t* nodes);
+void cache_store_perft(uint64_t key, uint8_t depth, uint64_t nodes);
+
+uint8_t cache_probe_moves(uint64_t key, uint8_t square, uint64_t* moves);
+void cache_store_moves(uint64_t key, uint8_t square, uint64_t moves);
+
+#endif
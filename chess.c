@@ -9,13 +9,19 @@
 #include "unifiedLcd.h"
 #include "rotary.h"
 
+#include "chess_core.h"
+#include "bits.h"
+#include "cache.h"
+#include "search.h"
+#include "book.h"
+#include "bench.h"
+
 // Turn on debugging during execution
 // (see all the ifdef DEBUG statements for usage)
 #define DEBUG 1
 
-/* Board size constraints */
+/* Board display constraints */
 
-#define BOARD_SIZE 8
 #define SQ_SIZE 30
 #define LEFT_OFFST 40
 
@@ -27,24 +33,10 @@
 #define LOCK_COL GREEN
 #define HL_COL 0xC618
 
-/* Piece type constants */
-
-#define EMPTY 0
-#define W_PAWN 1
-#define W_KNIGHT 2
-#define W_BISHOP 3
-#define W_ROOK 4
-#define W_QUEEN 5
-#define W_KING 6
-#define B_PAWN 7
-#define B_KNIGHT 8
-#define B_BISHOP 9
-#define B_ROOK 10
-#define B_QUEEN 11
-#define B_KING 12
-#define W_ALL 13
-#define B_ALL 14
-#define WB_ALL 15
+/* Gary Chess budget per move */
+
+#define GARY_DEPTH 16
+#define GARY_TIME_MS 5000
 
 /* Initialisation functions */
 
@@ -63,138 +55,50 @@ void reset_open_moves();
 void draw_checkmate();
 void draw_stalemate();
 void draw_indicator();
-
-/* Helper functions */
-
-uint8_t dp_to_rf(uint8_t x, uint8_t y);
-void rf_to_dp(uint8_t rf, uint8_t* x, uint8_t* y);
-
-/* Move square computations */
-
-uint64_t compute_king_incomplete(uint64_t king_loc, uint64_t own_side);
-
-
-uint64_t knight_attacked(uint64_t knight_loc);
-uint64_t knight_moveable(uint64_t knight_loc, uint64_t own_side);
-
-uint64_t white_pawn_attacked(uint64_t pawn_loc);
-uint64_t white_pawn_moveable(uint64_t pawn_loc);
-
-uint64_t black_pawn_attacked(uint64_t pawn_loc);
-uint64_t black_pawn_moveable(uint64_t pawn_loc);
-
-uint64_t rook_attacked(uint64_t rook_loc, uint64_t all_pieces);
-uint64_t rook_moveable(uint64_t rook_loc, uint64_t own_side, uint64_t all_pieces);
-
-uint64_t bishop_attacked(uint64_t bishop_loc, uint64_t all_pieces);
-uint64_t bishop_moveable(uint64_t bishop_loc, uint64_t own_side, uint64_t all_pieces);
-
-uint64_t queen_attacked(uint64_t queen_loc, uint64_t all_pieces);
-uint64_t queen_moveable(uint64_t queen_loc, uint64_t own_side, uint64_t all_pieces);
-
-/* "King danger" square computations */
-
-uint64_t compute_white_attacked_minus_black_king();
-uint64_t compute_black_attacked_minus_white_king();
-
-/* In-check capture and push mask computation */
-
-void is_white_checked(uint64_t king_loc, uint64_t* capture_mask, uint64_t* push_mask);
-void is_black_checked(uint64_t king_loc, uint64_t* capture_mask, uint64_t* push_mask);
-uint8_t is_double_checked(uint64_t capture_mask);
-
-/* Castling */
-
-uint64_t castle_set_white();
-uint64_t castle_set_black();
-void castle(uint64_t castle_square);
-
-const uint64_t WHITE_KING_INITIAL = 0x10;
-
-const uint64_t WHITE_KINGSIDE_ROOK =  0x80;
-const uint64_t WHITE_KINGSIDE_ROOK_CASTLED = 0x20;
-const uint64_t WHITE_KINGSIDE_KING_CASTLED = 0x40;
-
-const uint64_t WHITE_QUEENSIDE_ROOK = 0x1;
-const uint64_t WHITE_QUEENSIDE_ROOK_CASTLED = 0x8;
-const uint64_t WHITE_QUEENSIDE_KING_CASTLED = 0x4;
-
-const uint64_t BLACK_KING_INITIAL = 0x1000000000000000;
-
-const uint64_t BLACK_KINGSIDE_ROOK =         0x8000000000000000;
-const uint64_t BLACK_KINGSIDE_ROOK_CASTLED = 0x2000000000000000;
-const uint64_t BLACK_KINGSIDE_KING_CASTLED = 0x4000000000000000;
-
-const uint64_t BLACK_QUEENSIDE_ROOK =         0x0100000000000000;
-const uint64_t BLACK_QUEENSIDE_ROOK_CASTLED = 0x0800000000000000;
-const uint64_t BLACK_QUEENSIDE_KING_CASTLED = 0x0400000000000000;
-
-/* En passant */
-
-uint64_t en_passant =  0x000000FFFF000000;
-uint64_t non_passant = 0x0000000000000000;
-
-/* Piece pinned to king mask computation */
-
-uint64_t compute_pin_mask_white(uint64_t piece);
-uint64_t compute_pin_mask_black(uint64_t piece);
-
-uint64_t masks_white(uint64_t piece);
-uint64_t masks_black(uint64_t piece);
-
-/* Representational piece movement */
-
-void move_piece(uint64_t p, uint64_t q, uint8_t px, uint8_t py, uint8_t qx, uint8_t qy, uint8_t own_side, uint8_t enemy_side);
-uint64_t generate_moves(uint64_t piece_loc, uint8_t piece_type);
-void remove_piece(uint64_t piece_loc, uint8_t x, uint8_t y);
+void draw_changed_squares();
+void draw_menu_marker();
 
 /* Polling for basic game functions */
 
 void poll_selector();
 void poll_redraw_selected();
 void poll_move_gen();
+void poll_turn_moves();
+void poll_engine();
+void check_end_game();
+uint32_t clock_ms();
+
+#ifdef BENCH
+    void bench_print(const char* name, uint32_t cycles);
+#endif
 
 #ifdef DEBUG
     /* Debug functions (TODO: Can be removed if memory constrained) */
     void debug_bitboard(uint64_t bb);
-    const uint64_t ERROR_ERRONEOUS_CASTLE_CALL = 0xFF;
 #endif
 
-// Selector state enumeration
+// Game modes offered on the title screen
 enum {
-    SELECTOR_FREE,
-    SELECTOR_LOCKED,
+    MODE_PLAYER,
+    MODE_GARY
 };
 
-// Rank lookup table indexes
-enum {
-    RANK_1, RANK_2, RANK_3, RANK_4,
-    RANK_5, RANK_6, RANK_7, RANK_8
-};
+// Mode picked on the title screen (Gary Chess plays black)
+volatile uint8_t game_mode = MODE_PLAYER;
 
-// File lookup table indexes
-enum {
-    FILE_A, FILE_B, FILE_C, FILE_D,
-    FILE_E, FILE_F, FILE_G, FILE_H
-};
+// Is the title screen up? The rotary then moves between the modes.
+volatile uint8_t in_menu = 0;
+volatile uint8_t redraw_menu = 0;
 
-enum {
-    CASTLE_WHITE_KINGSIDE,
-    CASTLE_WHITE_QUEENSIDE,
-    CASTLE_BLACK_KINGSIDE,
-    CASTLE_BLACK_QUEENSIDE
-};
+// Milliseconds since start up, for the search time budget
+volatile uint32_t millis = 0;
 
+// Selector state enumeration
 enum {
-    PLAYER_WHITE,
-    PLAYER_BLACK
+    SELECTOR_FREE,
+    SELECTOR_LOCKED,
 };
 
-uint8_t current_player = PLAYER_WHITE;
-
-// Capture castling flags in a byte variable using enums above for indexing
-uint8_t castle_flags = 0x0F;
-
 // Encapsulate state of selection modes
 struct {
     uint8_t state;
@@ -203,21 +107,13 @@ struct {
     uint8_t lock_x, lock_y;
 } selector;
 
-// Piece type lookup table and visual representation
-// Note: indexed as [X][Y] NOT [ROW][COL] where (0,0) is top left
-// Right is +x, Down is +y
-uint8_t board[BOARD_SIZE][BOARD_SIZE];
-
-// Bitboards for efficient computation
-// FIXME: Not actually using all allocated bitboard memory here. Can limit array size further if needed.
-uint64_t bitboards[BOARD_SIZE * BOARD_SIZE];
-
-// Bitboards with only rank-file index bit set
-uint64_t piece[BOARD_SIZE * BOARD_SIZE];
-
 // Moves open to player on board
 uint64_t open_moves;
 
+// Legal destinations of each square for the side to move, filled once per turn
+uint64_t turn_moves[BOARD_SIZE * BOARD_SIZE];
+uint8_t turn_moves_valid = 0;
+
 // Is the open move buffer valid? Or does it need re-computing?
 uint8_t open_valid = 0;
 
@@ -228,53 +124,6 @@ volatile uint8_t redraw_select = 0;
 // TODO: Future extension - Replace visual characters with sprites?
 const char* display_pieces = " PNBRQKpnbrqk";
 
-/* Lookup tables */
-
-const uint64_t clear_rank[BOARD_SIZE] = {
-    0xFFFFFFFFFFFFFF00,
-    0xFFFFFFFFFFFF00FF,
-    0xFFFFFFFFFF00FFFF,
-    0xFFFFFFFF00FFFFFF,
-    0xFFFFFF00FFFFFFFF,
-    0xFFFF00FFFFFFFFFF,
-    0xFF00FFFFFFFFFFFF,
-    0x00FFFFFFFFFFFFFF
-};
-
-
-const uint64_t mask_rank[BOARD_SIZE] = {
-    0x00000000000000FF,
-    0x000000000000FF00,
-    0x0000000000FF0000,
-    0x00000000FF000000,
-    0x000000FF00000000,
-    0x0000FF0000000000,
-    0x00FF000000000000,
-    0xFF00000000000000
-};
-
-const uint64_t clear_file[BOARD_SIZE] = {
-    0xFEFEFEFEFEFEFEFE,
-    0xFDFDFDFDFDFDFDFD,
-    0xFBFBFBFBFBFBFBFB,
-    0xF7F7F7F7F7F7F7F7,
-    0xEFEFEFEFEFEFEFEF,
-    0xDFDFDFDFDFDFDFDF,
-    0xBFBFBFBFBFBFBFBF,
-    0x7F7F7F7F7F7F7F7F
-};
-
-const uint64_t mask_file[BOARD_SIZE] = {
-    0x0101010101010101,
-    0x0202020202020202,
-    0x0404040404040404,
-    0x0808080808080808,
-    0x1010101010101010,
-    0x2020202020202020,
-    0x4040404040404040,
-    0x8080808080808080
-};
-
 const char sprites[6][10*10] = {
 
     ".........."
@@ -388,7 +237,14 @@ void draw_sprite(const char* sprite, uint8_t x, uint8_t y, uint8_t is_white) {
 /* Handle rotary encoder changes on timer interrupts */
 ISR(TIMER1_COMPA_vect) {
 
-    if (rotary) {
+    if (rotary && in_menu) {
+
+        // Up picks the first mode, down the second
+        game_mode = (rotary > 0) ? MODE_PLAYER : MODE_GARY;
+        redraw_menu = 1;
+        rotary = 0;
+
+    } else if (rotary) {
 
         // Store the previously selected square (needs to be redrawn)
         selector.sel_x_last = selector.sel_x;
@@ -425,6 +281,11 @@ ISR(TIMER1_COMPA_vect) {
 
 }
 
+/* Millisecond tick for the search clock */
+ISR(TIMER3_COMPA_vect) {
+    millis++;
+}
+
 int main() {
 
     // Turn off default prescaling of clock (AT90USB DS, p. 48)
@@ -447,6 +308,20 @@ int main() {
     // Clock already prescaled so set clock option to 0
     init_lcd(0);
 
+#ifdef BENCH
+    // Keep the rotary timer from stealing cycles while measuring
+    TIMSK1 &= ~_BV(OCIE1A);
+    run_benchmarks(bench_print);
+    for (;;) {}
+#endif
+
+    // Millisecond clock for the search (Timer 3 CTC, 8 MHz / 64 / 125).
+    // The benchmarks above use Timer 3 as a free running cycle counter instead.
+    TCCR3A = 0;
+    TCCR3B = _BV(WGM32) | _BV(CS31) | _BV(CS30);
+    OCR3A = 124;
+    TIMSK3 |= _BV(OCIE3A);
+
     cli();
 
     // const char* board_rep =
@@ -521,10 +396,16 @@ int main() {
 
     sei();
 
+    in_menu = 1;
     draw_tile();
     for (;;) {
+        if (redraw_menu) {
+            redraw_menu = 0;
+            draw_menu_marker();
+        }
         if (~PINE & _BV(SWC)) break;
     }
+    in_menu = 0;
 
     cli();
 
@@ -543,7 +424,9 @@ int main() {
     for (;;) {
         poll_redraw_selected();
         poll_selector();
+        poll_turn_moves();
         poll_move_gen();
+        poll_engine();
     }
     cli();
 
@@ -636,117 +519,18 @@ void poll_selector() {
                 // Move piece
                 uint8_t rf_old = dp_to_rf(selector.lock_x, selector.lock_y);
 
+                play_move(rf_old, rf);
+                turn_moves_valid = 0;
 
-                if ( ( ( bitboards[W_KING] & piece[rf_old] ) && ( bitboards[W_ROOK] & piece[rf] ) ) ||
-                     ( ( bitboards[B_KING] & piece[rf_old] ) && ( bitboards[B_ROOK] & piece[rf] ) ) ) {
-                    castle(piece[rf]);
-                } else if ( ( ( bitboards[W_ROOK] & piece[rf_old] ) && ( bitboards[W_KING] & piece[rf] ) ) || 
-                            ( ( bitboards[B_ROOK] & piece[rf_old] ) && ( bitboards[B_KING] & piece[rf] ) ) ) {
-                    castle(piece[rf_old]);
-                } else {
-
-                    uint8_t ty = board[selector.lock_x][selector.lock_y];
-                    uint8_t own_side = (ty < B_PAWN) ? W_ALL : B_ALL;
-                    uint8_t enemy_side = (own_side == W_ALL) ? B_ALL : W_ALL;
-
-                    move_piece(piece[rf_old], piece[rf], selector.lock_x, selector.lock_y, selector.sel_x, selector.sel_y, own_side, enemy_side);
-
-                    // Redraw old position
-                    uint16_t col = ((selector.lock_x + selector.lock_y) & 1) ? DK_SQ_COL : LT_SQ_COL;
-                    draw_square(selector.lock_x, selector.lock_y, col);
-                    draw_piece(selector.lock_x, selector.lock_y);
-
-                    // Redraw new position
-                    draw_square(selector.sel_x, selector.sel_y, HL_COL);
-                    draw_piece(selector.sel_x, selector.sel_y);
-
-                }
+                // Repaint whatever the move changed (both ends, a castling rook, a pawn taken en passant)
+                draw_changed_squares();
 
-                // Update en passant tables
-                en_passant &= ~non_passant;
-                non_passant |= (bitboards[B_PAWN] & mask_rank[RANK_5]) | (bitboards[W_PAWN] & mask_rank[RANK_4]);
+                // The selector is still over the destination
+                draw_square(selector.sel_x, selector.sel_y, HL_COL);
+                draw_piece(selector.sel_x, selector.sel_y);
 
                 // Check for end game
-
-                uint64_t capture_mask_black = 0;
-                uint64_t capture_mask_white = 0;
-                uint64_t push_mask = 0;
-                uint64_t move_set_black = 0;
-                uint64_t move_set_white = 0;
-
-                // Check if mated
-                is_black_checked(bitboards[B_KING], &capture_mask_black, &push_mask);
-                push_mask = 0;
-                is_white_checked(bitboards[W_KING], &capture_mask_white, &push_mask);
-
-                // Highlight checks
-                if (capture_mask_white) {
-
-                    // Find white king
-                    uint8_t x, y;
-                    for (uint8_t i = 0; i < 63; i++) {
-                        if ((bitboards[W_KING] >> i) & 1) {
-                            rf_to_dp(i, &x, &y);
-                        }
-                    }
-
-                    draw_square(x, y, RED);
-                    draw_piece(x, y);
-
-                } else if (capture_mask_black) {
-
-                    // Find black king
-                    uint8_t x, y;
-                    for (uint8_t i = 0; i < 63; i++) {
-                        if ((bitboards[B_KING] >> i) & 1) {
-                            rf_to_dp(i, &x, &y);
-                        }
-                    }
-
-                    draw_square(x, y, RED);
-                    draw_piece(x, y);
-                }
-
-                // Compute move set for all of black's pieces
-
-                // WARNING: Risk of stack crashing into heap here. Sanity check this.
-                for (uint8_t i = B_PAWN; i <= B_KING; i++) {
-                    move_set_black |= generate_moves(bitboards[i], i);
-                }
-
-                for (uint8_t i = W_PAWN; i <= W_KING; i++) {
-                    move_set_white |= generate_moves(bitboards[i], i);
-                }
-
-                if (move_set_black == 0) {
-
-                    if (capture_mask_black) {
-                        // CHECKMATE
-                        draw_checkmate();
-                        for(;;) {}
-
-                    } else {
-                        // STALEMATE
-                        draw_stalemate();
-                        for (;;) {}
-                    }
-                    
-                }
-
-                if (move_set_white == 0) {
-
-                    if (capture_mask_white) {
-                        // CHECKMATE
-                        draw_checkmate();
-                        for(;;) {}
-
-                    } else {
-                        // STALEMATE
-                        draw_stalemate();
-                        for (;;) {}
-                    }
-                    
-                }
+                check_end_game();
 
                 // // TODO: Analyse check-mate
                 // switch (current_player) {
@@ -817,9 +601,7 @@ void poll_selector() {
                 //         break;
                 // }
 
-                // Next player's turn
-                current_player = (current_player + 1) % 2;
-
+                // Indicate next player's turn
                 draw_indicator();
 
 
@@ -851,218 +633,174 @@ void poll_selector() {
     }
 }
 
-/* Computes move generation for the selected piece */
-void poll_move_gen() {
-
-    // Only compute possible moves when a piece is locked and the move buffer is invalidated
-    if (selector.state == SELECTOR_LOCKED && open_valid == 0) {
-
-        uint8_t rf = dp_to_rf(selector.lock_x, selector.lock_y);
-
-        open_moves = generate_moves(piece[rf], board[selector.lock_x][selector.lock_y]);
-
-        // Moves have been computed, so draw them
-        draw_open_moves();
-
-        // Validate open move buffer
-        open_valid = 1;
-    }
-}
-
-uint64_t generate_moves(uint64_t piece_loc, uint8_t piece_type) {
-    switch(piece_type) {
-
-        case EMPTY:
-
-            // OK, Idiot.
-
-            open_valid = 1;
-            return 0;
-        
-
-        case B_KING:
-
-            return compute_king_incomplete(piece_loc, bitboards[B_ALL]) &
-                            ~compute_white_attacked_minus_black_king() | 
-                            castle_set_black();
-            break;
-
-
-        case W_KING:
-
-            return compute_king_incomplete(piece_loc, bitboards[W_ALL]) &
-                            ~compute_black_attacked_minus_white_king() |
-                            castle_set_white();
-            break;
-
-
-        case B_KNIGHT:
-
-            return knight_moveable(piece_loc, bitboards[B_ALL]) & masks_black(piece_loc);
-
-            break;
+/* Highlights a king in check and ends the game on checkmate or stalemate */
+void check_end_game() {
 
+    uint64_t capture_mask_black = 0;
+    uint64_t capture_mask_white = 0;
+    uint64_t push_mask = 0;
 
-        case W_KNIGHT:
+    // Check if mated
+    is_black_checked(bitboards[B_KING], &capture_mask_black, &push_mask);
+    push_mask = 0;
+    is_white_checked(bitboards[W_KING], &capture_mask_white, &push_mask);
 
-            return knight_moveable(piece_loc, bitboards[W_ALL]) & masks_white(piece_loc);
+    // Highlight checks
+    if (capture_mask_white) {
 
-            break;
+        // Find white king
+        uint8_t x, y;
+        rf_to_dp(lsb(bitboards[W_KING]), &x, &y);
 
+        draw_square(x, y, RED);
+        draw_piece(x, y);
 
-        case B_PAWN:
+    } else if (capture_mask_black) {
 
-            return black_pawn_moveable(piece_loc) & masks_black(piece_loc);
+        // Find black king
+        uint8_t x, y;
+        rf_to_dp(lsb(bitboards[B_KING]), &x, &y);
 
-            break;
+        draw_square(x, y, RED);
+        draw_piece(x, y);
+    }
 
-        case W_PAWN:
+    // The side to move is mated or stalemated if it has no legal move (which stops
+    // at the first one found, the turn's table is left to fill in the main loop)
+    if (!side_has_legal_move()) {
 
-            return white_pawn_moveable(piece_loc) & masks_white(piece_loc);
+        if ((current_player == PLAYER_WHITE) ? capture_mask_white : capture_mask_black) {
+            // CHECKMATE
+            draw_checkmate();
+            for(;;) {}
 
-            break;
+        } else {
+            // STALEMATE
+            draw_stalemate();
+            for (;;) {}
+        }
 
-        case B_ROOK:
+    }
+}
 
-            return rook_moveable(piece_loc, bitboards[B_ALL], bitboards[WB_ALL]) & masks_black(piece_loc);
+/* Lets Gary Chess reply when it is black's turn */
+void poll_engine() {
 
-            break;
+    if (game_mode != MODE_GARY || current_player != PLAYER_BLACK) return;
 
-        case W_ROOK:
+    // Known openings are played from the book straight away
+    uint16_t move = book_move((uint16_t) clock_ms());
 
-            return rook_moveable(piece_loc, bitboards[W_ALL], bitboards[WB_ALL]) & masks_white(piece_loc);
+    if (move == NULL_MOVE) {
+        search_limits limits = { GARY_DEPTH, 0, GARY_TIME_MS, clock_ms };
+        search_result result;
 
-            break;
+        search(&limits, &result);
+        move = result.move;
 
-        case B_BISHOP:
-
-            return bishop_moveable(piece_loc, bitboards[B_ALL], bitboards[WB_ALL]) & masks_black(piece_loc);
+        // The search leaves the position as it found it, but not the repaint set
+        take_changed_squares();
+    }
 
-            break;
+    cli();
 
-        case W_BISHOP:
+    apply_move(move);
+    turn_moves_valid = 0;
+    draw_changed_squares();
 
-            return bishop_moveable(piece_loc, bitboards[W_ALL], bitboards[WB_ALL]) & masks_white(piece_loc);
+    // Keep the selector visible if the reply landed on it
+    draw_square(selector.sel_x, selector.sel_y, HL_COL);
+    draw_piece(selector.sel_x, selector.sel_y);
 
-            break;
+    check_end_game();
+    draw_indicator();
 
-        case B_QUEEN:
+    sei();
+}
 
-            return queen_moveable(piece_loc, bitboards[B_ALL], bitboards[WB_ALL]) & masks_black(piece_loc);
+/* Milliseconds since start up */
+uint32_t clock_ms() {
+    uint8_t sreg = SREG;
+    cli();
+    uint32_t ms = millis;
+    SREG = sreg;
+    return ms;
+}
 
-            break;
+/* Works out the legal destinations of every piece of the side to move, once a turn.
+ * A position seen before is refilled from the position cache when every piece's
+ * entry is still there; otherwise the moves are generated and cached per square.
+ */
+void poll_turn_moves() {
 
-        case W_QUEEN:
+    if (turn_moves_valid) return;
 
-            return queen_moveable(piece_loc, bitboards[W_ALL], bitboards[WB_ALL]) & masks_white(piece_loc);
+    uint64_t own = bitboards[(current_player == PLAYER_WHITE) ? W_ALL : B_ALL];
+    uint8_t hit = 1;
 
-            break;
+    memset(turn_moves, 0, sizeof(turn_moves));
 
-        default:
+    for_each_bit(rf, own) {
+        if (!cache_probe_moves(hash_key, rf, &turn_moves[rf])) {
+            hit = 0;
             break;
-
+        }
     }
-}
-
-uint64_t masks_white(uint64_t piece) {
-
-    uint64_t capture_mask = 0;
-    uint64_t push_mask = 0;
-    uint64_t pin_mask = 0;
-
-    uint64_t total_mask = 0xFFFFFFFFFFFFFFFF;
-
-    is_white_checked(bitboards[W_KING], &capture_mask, &push_mask);
-    // debug_bitboard(capture_mask);
 
-    if (capture_mask) {
-        if (is_double_checked(capture_mask)) {
-            total_mask = 0;
-            return total_mask;
+    if (!hit) {
+        legal_destinations(turn_moves);
+        for_each_bit(rf, own) {
+            cache_store_moves(hash_key, rf, turn_moves[rf]);
         }
-        total_mask &= capture_mask | push_mask;
     }
 
-    pin_mask = compute_pin_mask_white(piece);
-    total_mask &= pin_mask & ~bitboards[B_KING];
-
-    return total_mask;
-
+    turn_moves_valid = 1;
 }
 
-uint64_t masks_black(uint64_t piece) {
-
-    uint64_t capture_mask = 0;
-    uint64_t push_mask = 0;
-    uint64_t pin_mask = 0;
-
-    uint64_t total_mask = 0xFFFFFFFFFFFFFFFF;
-
-    is_black_checked(bitboards[B_KING], &capture_mask, &push_mask);
+/* Computes move generation for the selected piece */
+void poll_move_gen() {
 
-    if (capture_mask) {
-        if (is_double_checked(capture_mask)) {
-            total_mask = 0;
-            return total_mask;
-        }
-        total_mask &= capture_mask | push_mask;
-    }
-    
-    pin_mask = compute_pin_mask_black(piece);
-    total_mask &= pin_mask & ~bitboards[W_KING];
+    // Only compute possible moves when a piece is locked and the move buffer is invalidated
+    if (selector.state == SELECTOR_LOCKED && open_valid == 0) {
 
-    return total_mask;
+        uint8_t rf = dp_to_rf(selector.lock_x, selector.lock_y);
 
-}
+        // Usually filled while the player was still picking the piece
+        poll_turn_moves();
+        open_moves = turn_moves[rf];
 
-/* Determines if a check is a double check from the capture mask */
-uint8_t is_double_checked(uint64_t capture_mask) {
+        // Moves have been computed, so draw them
+        draw_open_moves();
 
-    // WARNING: Bit hack detects if number is a power of 2 but incorrectly
-    // recognises 0, so use AFTER ensuring there is a check.
-    return (capture_mask & (capture_mask - 1)) != 0;
+        // Validate open move buffer
+        open_valid = 1;
+    }
 }
 
 /* Resets the colours of the current open move squares */
 void reset_open_moves() {
-    for (uint8_t i = 0; i < BOARD_SIZE * BOARD_SIZE; i++) {
-        if (open_moves & piece[i]) {
-            uint8_t y_pos;
-            uint8_t x_pos;
-            rf_to_dp(i, &x_pos, &y_pos);
-            uint16_t col = ((x_pos + y_pos) & 1) ? DK_SQ_COL : LT_SQ_COL;
-            draw_square(x_pos, y_pos, col);
-            draw_piece(x_pos, y_pos);
-        }
+    for_each_bit(i, open_moves) {
+        uint8_t y_pos;
+        uint8_t x_pos;
+        rf_to_dp(i, &x_pos, &y_pos);
+        uint16_t col = ((x_pos + y_pos) & 1) ? DK_SQ_COL : LT_SQ_COL;
+        draw_square(x_pos, y_pos, col);
+        draw_piece(x_pos, y_pos);
     }
     open_moves = 0;
 }
 
 /* Draw squares set in the open move buffer */
 void draw_open_moves() {
-    for (uint8_t i = 0; i < BOARD_SIZE * BOARD_SIZE; i++) {
-        if (open_moves & piece[i]) {
-            uint8_t y_pos;
-            uint8_t x_pos;
-            rf_to_dp(i, &x_pos, &y_pos);
-            draw_square(x_pos, y_pos, OPN_COL);
-            draw_piece(x_pos, y_pos);
-        }
+    for_each_bit(i, open_moves) {
+        uint8_t y_pos;
+        uint8_t x_pos;
+        rf_to_dp(i, &x_pos, &y_pos);
+        draw_square(x_pos, y_pos, OPN_COL);
+        draw_piece(x_pos, y_pos);
     }
 }
 
-/* Convert a square-relative display coordinate into a rank-file index */
-uint8_t dp_to_rf(uint8_t x, uint8_t y) {
-    y = BOARD_SIZE - y - 1;
-    return x + y * BOARD_SIZE;
-}
-
-/* Convert a rank-file index into a square-relative display coordinate */
-void rf_to_dp(uint8_t rf, uint8_t* x, uint8_t* y) {
-    *y = BOARD_SIZE - 1 - rf / BOARD_SIZE;
-    *x = rf % BOARD_SIZE;
-}
-
 void draw_checkmate() {
     cli();
 
@@ -1132,6 +870,19 @@ void draw_indicator() {
     sei();
 }
 
+/* Repaints the squares the rules engine has changed since the last repaint */
+void draw_changed_squares() {
+    uint64_t changed = take_changed_squares();
+    for_each_bit(i, changed) {
+        uint8_t y_pos;
+        uint8_t x_pos;
+        rf_to_dp(i, &x_pos, &y_pos);
+        uint16_t col = ((x_pos + y_pos) & 1) ? DK_SQ_COL : LT_SQ_COL;
+        draw_square(x_pos, y_pos, col);
+        draw_piece(x_pos, y_pos);
+    }
+}
+
 /* Draw all squares on the board */
 void draw_board() {
     uint16_t i, j;
@@ -1213,22 +964,56 @@ void draw_tile() {
     display_string_xy("KE2 FORTUNA MICRO CHESS", 60, 40);
 
     display_string_xy("Player vs Player", 60, 105);
-    display_string_xy("Player vs Gary Chess (coming soon)", 60, 125);
+    display_string_xy("Player vs Gary Chess", 60, 125);
 
     display_string_xy("(c) 2021 Dulhan Jayalath", 60, 210);
 
-    r.left = 180;
-    r.right = 185;
+    sei();
+
+    draw_menu_marker();
+
+}
+
+/* Marks the game mode picked on the title screen */
+void draw_menu_marker() {
+
+    cli();
+
+    rectangle r;
+    r.left = 45;
+    r.right = 50;
+
     r.top = 105;
     r.bottom = 110;
+    fill_rectangle(r, (game_mode == MODE_PLAYER) ? WHITE : BLACK);
 
-    fill_rectangle(r, WHITE);
+    r.top = 125;
+    r.bottom = 130;
+    fill_rectangle(r, (game_mode == MODE_GARY) ? WHITE : BLACK);
 
+    sei();
 
+}
 
-    sei();
+#ifdef BENCH
+/* Print one benchmark result per screen line */
+void bench_print(const char* name, uint32_t cycles) {
+    static uint16_t line = 0;
+    char digits[11];
+
+    // A full screen stays up for a while before the next page
+    if (10 + line + 8 > display.height) {
+        _delay_ms(10000);
+        clear_screen();
+        line = 0;
+    }
 
+    display_string_xy((char*) name, 10, 10 + line);
+    ultoa(cycles, digits, 10);
+    display_string_xy(digits, 200, 10 + line);
+    line += 10;
 }
+#endif
 
 /* Display a bitboard on screen for debugging. */
 // WHITE = 1, GREY = 0
@@ -1260,963 +1045,5 @@ void init_pieces(const char* board_rep) {
     selector.sel_x_last = 0;
     selector.sel_y_last = 0;
 
-    uint64_t ONE_64 = 1;
-
-    uint8_t i = 0;
-    uint8_t x = 0;
-    uint8_t y = 0;
-    while (board_rep[i]) {
-
-        uint8_t j = dp_to_rf(x, y);
-
-        switch (board_rep[i]) {
-
-            case 'P':
-                bitboards[W_PAWN] |= ONE_64 << j;
-                board[x][y] = W_PAWN;
-                break;
-            case 'R':
-                bitboards[W_ROOK] |= ONE_64 << j;
-                board[x][y] = W_ROOK;
-                break;
-            case 'N':
-                bitboards[W_KNIGHT] |= ONE_64 << j;
-                board[x][y] = W_KNIGHT;
-                break;
-            case 'B':
-                bitboards[W_BISHOP] |= ONE_64 << j;
-                board[x][y] = W_BISHOP;
-                break;
-            case 'Q':
-                bitboards[W_QUEEN] |= ONE_64 << j;
-                board[x][y] = W_QUEEN;
-                break;
-            case 'K':
-                bitboards[W_KING] |= ONE_64 << j;
-                board[x][y] = W_KING;
-                break;
-
-            case 'p':
-                bitboards[B_PAWN] |= ONE_64 << j;
-                board[x][y] = B_PAWN;
-                break;
-            case 'r':
-                bitboards[B_ROOK] |= ONE_64 << j;
-                board[x][y] = B_ROOK;
-                break;
-            case 'n':
-                bitboards[B_KNIGHT] |= ONE_64 << j;
-                board[x][y] = B_KNIGHT;
-                break;
-            case 'b':
-                bitboards[B_BISHOP] |= ONE_64 << j;
-                board[x][y] = B_BISHOP;
-                break;
-            case 'q':
-                bitboards[B_QUEEN] |= ONE_64 << j;
-                board[x][y] = B_QUEEN;
-                break;
-            case 'k':
-                bitboards[B_KING] |= ONE_64 << j;
-                board[x][y] = B_KING;
-                break;
-
-            default:
-                break;
-
-        }
-
-        if (x + 1 >= BOARD_SIZE) {
-            x = 0;
-            y++;
-        } else {
-            x++;
-        }
-        
-        i++;
-    }
-
-    // All bitboards (remember to keep these updated!)
-    bitboards[W_ALL] = bitboards[W_PAWN] | bitboards[W_ROOK] | bitboards[W_KNIGHT] | bitboards[W_BISHOP] | bitboards[W_QUEEN] | bitboards[W_KING];
-    bitboards[B_ALL] = bitboards[B_PAWN] | bitboards[B_ROOK] | bitboards[B_KNIGHT] | bitboards[B_BISHOP] | bitboards[B_QUEEN] | bitboards[B_KING];
-    bitboards[WB_ALL] = bitboards[W_ALL] | bitboards[B_ALL];
-
-    for (uint64_t i = 0; i < BOARD_SIZE * BOARD_SIZE; i++) {
-        uint64_t one = 1;
-        piece[i] = one << i;
-    }
-
-
-    // /* Setup bitboards */
-
-    // // RIGHT shift is towards LSB and is equivalent to moving a piece LEFT.
-    // // White pieces are nearest LSB.
-    // // See mapping: http://pages.cs.wisc.edu/~psilord/blog/data/chess-pages/rep.html
-
-    // const uint64_t pawns = 0x0000;
-    // // const uint64_t pawns = 0xFF00;
-    // const uint64_t rooks = 0x81;
-    // const uint64_t knights = 0x00;
-    // // const uint64_t knights = 0x42;
-    // const uint64_t bishops = 0x24;
-    // const uint64_t queens = 0x8;
-    // const uint64_t kings = 0x10;
-
-    // // White bitboards
-    // bitboards[W_PAWN] =   pawns;
-    // bitboards[W_ROOK] =   rooks;
-    // bitboards[W_KNIGHT] = knights;
-    // bitboards[W_BISHOP] = bishops;
-    // bitboards[W_QUEEN] =  queens;
-    // bitboards[W_KING] =   kings;
-
-    // // Black bitboards
-    // bitboards[B_PAWN] =   pawns << 40;
-    // bitboards[B_ROOK] =   rooks << 56;
-    // bitboards[B_KNIGHT] = knights << 56;
-    // bitboards[B_BISHOP] = bishops << 56;
-    // bitboards[B_QUEEN] =  queens << 56;
-    // bitboards[B_KING] =   kings << 56;
-
-    // // All bitboards (remember to keep these updated!)
-    // bitboards[W_ALL] = bitboards[W_PAWN] | bitboards[W_ROOK] | bitboards[W_KNIGHT] | bitboards[W_BISHOP] | bitboards[W_QUEEN] | bitboards[W_KING];
-    // bitboards[B_ALL] = bitboards[B_PAWN] | bitboards[B_ROOK] | bitboards[B_KNIGHT] | bitboards[B_BISHOP] | bitboards[B_QUEEN] | bitboards[B_KING];
-    // bitboards[WB_ALL] = bitboards[W_ALL] | bitboards[B_ALL];
-
-    // for (uint64_t i = 0; i < BOARD_SIZE * BOARD_SIZE; i++) {
-    //     uint64_t one = 1;
-    //     piece[i] = one << i;
-    // }
-
-    // // debug_bitboard(piece[28]);
-
-    // /* Setup display board */
-
-    // // Clear board
-    // memset(board, EMPTY, sizeof(board));
-
-    // // Pawns
-    // uint8_t i;
-    // for (i = 0; i < BOARD_SIZE; i++) {
-    //     board[i][1] = B_PAWN;
-    //     board[i][6] = W_PAWN;
-    // }
-
-    // // Black pieces
-    // board[0][0] = B_ROOK;
-    // board[1][0] = B_KNIGHT;
-    // board[2][0] = B_BISHOP;
-    // board[3][0] = B_QUEEN;
-    // board[4][0] = B_KING;
-    // board[5][0] = B_BISHOP;
-    // board[6][0] = B_KNIGHT;
-    // board[7][0] = B_ROOK;
-
-    // // White pieces
-    // board[0][7] = W_ROOK;
-    // board[1][7] = W_KNIGHT;
-    // board[2][7] = W_BISHOP;
-    // board[3][7] = W_QUEEN;
-    // board[4][7] = W_KING;
-    // board[5][7] = W_BISHOP;
-    // board[6][7] = W_KNIGHT;
-    // board[7][7] = W_ROOK;
-
+    init_board(board_rep);
 }
-
-/* Compute the bitboard of valid moves for a king */
-uint64_t compute_king_incomplete(uint64_t king_loc, uint64_t own_side) {
-
-    // Account for file overflow/underflow
-    uint64_t king_clip_h = king_loc & clear_file[FILE_H];
-    uint64_t king_clip_a = king_loc & clear_file[FILE_A];
-
-    // If bits (NOT necessarily the piece) are moving right by more than one,
-    // we should clip.
-    uint64_t pos_1 = king_clip_a << 7; // NW
-    // uint64_t pos_1 = king_clip_h << 7; // NW
-    uint64_t pos_2 = king_loc << 8; // N
-    uint64_t pos_3 = king_clip_h << 9; // NE
-    uint64_t pos_4 = king_clip_h << 1;
-
-    uint64_t pos_5 = king_clip_h >> 7;
-    // uint64_t pos_5 = king_clip_a >> 7;
-    uint64_t pos_6 = king_loc >> 8;
-    uint64_t pos_7 = king_clip_a >> 9;
-    uint64_t pos_8 = king_clip_a >> 1;
-
-    uint64_t king_moves = pos_1 | pos_2 | pos_3 | pos_4 | pos_5 | pos_6 | pos_7 | pos_8;
-
-    return king_moves & ~own_side;
-}
-
-/* Set of squares attacked by a knight */
-uint64_t knight_attacked(uint64_t knight_loc) {
-
-    // Account for file overflow/underflow
-    uint64_t clip_1 = clear_file[FILE_A] & clear_file[FILE_B];
-    uint64_t clip_2 = clear_file[FILE_A];
-    uint64_t clip_3 = clear_file[FILE_H];
-    uint64_t clip_4 = clear_file[FILE_H] & clear_file[FILE_G];
-    uint64_t clip_5 = clear_file[FILE_H] & clear_file[FILE_G];
-    uint64_t clip_6 = clear_file[FILE_H];
-    uint64_t clip_7 = clear_file[FILE_A];
-    uint64_t clip_8 = clear_file[FILE_A] & clear_file[FILE_B];
-
-    uint64_t pos_1 = (knight_loc & clip_1) << 6;
-    uint64_t pos_2 = (knight_loc & clip_2) << 15;
-    uint64_t pos_3 = (knight_loc & clip_3) << 17;
-    uint64_t pos_4 = (knight_loc & clip_4) << 10;
-
-    uint64_t pos_5 = (knight_loc & clip_5) >> 6;
-    uint64_t pos_6 = (knight_loc & clip_6) >> 15;
-    uint64_t pos_7 = (knight_loc & clip_7) >> 17;
-    uint64_t pos_8 = (knight_loc & clip_8) >> 10;
-
-    uint64_t knight_attacked = pos_1 | pos_2 | pos_3 | pos_4 | pos_5 | pos_6 | pos_7 | pos_8;
-
-    return knight_attacked;
-}
-
-/* Set of squares a knight can move to */
-uint64_t knight_moveable(uint64_t knight_loc, uint64_t own_side) {
-    return knight_attacked(knight_loc) & ~own_side;
-}
-
-/* Set of squares attacked by a white pawn */
-uint64_t white_pawn_attacked(uint64_t pawn_loc) {
-
-    // Left and right attacks
-    uint64_t left_att = (pawn_loc & clear_file[FILE_A]) << 7;
-    uint64_t right_att = (pawn_loc & clear_file[FILE_H]) << 9;
-
-    return left_att | right_att;
-}
-
-/* Set of squares a white pawn can move to */
-uint64_t white_pawn_moveable(uint64_t pawn_loc) {
-
-    // Calculate pawn moves
-
-    // Single space in front of pawn
-    uint64_t one_step = (pawn_loc << 8) & ~bitboards[WB_ALL];
-
-    // Check second step if one step is possible from rank 2
-    uint64_t two_step = ((one_step & mask_rank[RANK_3]) << 8) & ~bitboards[WB_ALL];
-
-    uint64_t valid_moves = one_step | two_step;
-    uint64_t valid_att = white_pawn_attacked(pawn_loc) & bitboards[B_ALL];
-
-    // Compute en passant attacks
-    uint64_t ep_att = white_pawn_attacked(pawn_loc & mask_rank[RANK_5]) & ((bitboards[B_PAWN] & en_passant) << 8);
-
-    return valid_moves | valid_att | ep_att;
-}
-
-/* Set of squares attacked by a black pawn */
-uint64_t black_pawn_attacked(uint64_t pawn_loc) {
-
-    uint64_t left_att = (pawn_loc & clear_file[FILE_A]) >> 9;
-    uint64_t right_att = (pawn_loc & clear_file[FILE_H]) >> 7;
-
-    // TODO: En passant
-
-    return left_att | right_att;
-}
-
-/* Set of squares a black pawn can move to */
-uint64_t black_pawn_moveable(uint64_t pawn_loc) {
-
-    // Calculate pawn moves
-
-    // Single space in front of pawn
-    uint64_t one_step = (pawn_loc >> 8) & ~bitboards[WB_ALL];
-
-    // Check second step if one step is possible from rank 7
-    uint64_t two_step = ((one_step & mask_rank[RANK_6]) >> 8) & ~bitboards[WB_ALL];
-
-    uint64_t valid_moves = one_step | two_step;
-    uint64_t valid_att = black_pawn_attacked(pawn_loc) & bitboards[W_ALL];
-
-    // Compute en passant attacks
-    uint64_t ep_att = black_pawn_attacked(pawn_loc & mask_rank[RANK_4]) & ((bitboards[W_PAWN] & en_passant) >> 8);
-
-    return valid_moves | valid_att | ep_att;
-
-}
-
-/* Set of squares attacked by a rook */
-uint64_t rook_attacked(uint64_t rook_loc, uint64_t all_pieces) {
-
-    // Rays are horizontal and vertical
-    // => We can use masks!
-
-    // Memory constraints => we can't use lookup tables here.
-    // Would require 8 * 256 * 8 * 2 = 33kB > 8kB RAM for all combinations.
-
-    // We need to stop the ray as soon as it hits the first enemy piece
-
-    uint64_t valid = 0;
-
-    for (uint8_t rf = 0; rf < BOARD_SIZE * BOARD_SIZE; rf++) {
-
-        if (rook_loc & piece[rf]) {
-
-            // Build upward ray
-            int8_t p = rf;
-            while (p + 8 < BOARD_SIZE * BOARD_SIZE) {
-                p += 8;
-                valid |= piece[p];
-                if (piece[p] & all_pieces) break;
-            }
-
-            // Build downward ray
-            p = rf;
-            while (p - 8 >= 0) {
-                p -= 8;
-                valid |= piece[p];
-                if (piece[p] & all_pieces) break;
-            }
-
-            uint8_t left_edge = (rf / BOARD_SIZE) * BOARD_SIZE;
-            uint8_t right_edge = left_edge + BOARD_SIZE - 1;
-
-            // Build right ray
-            p = rf;
-            while ((p + 1) <= right_edge) {
-                p++;
-                valid |= piece[p];
-                if (piece[p] & all_pieces) break;
-            }
-
-            // Build left ray
-            p = rf;
-            while ((p - 1) >= left_edge) {
-                p--;
-                valid |= piece[p];
-                if (piece[p] & all_pieces) break;
-            }
-
-        }
-
-    }    
-
-    return valid;
-}
-
-/* Set of squares a rook can move to */
-uint64_t rook_moveable(uint64_t rook_loc, uint64_t own_side, uint64_t all_pieces) {
-    return rook_attacked(rook_loc, all_pieces) & ~own_side;
-}
-
-/* Set of squares attacked by a bishop */
-uint64_t bishop_attacked(uint64_t bishop_loc, uint64_t all_pieces) {
-
-    uint64_t valid = 0;
-
-    for (uint8_t rf = 0; rf < BOARD_SIZE * BOARD_SIZE; rf++) {
-
-        if (bishop_loc & piece[rf]) {
-
-            uint8_t x, y;
-            rf_to_dp(rf, &x, &y);
-
-            uint8_t x_tmp = x;
-            uint8_t y_tmp = y;
-            uint8_t p;
-
-            // TR
-            while(x_tmp + 1 < BOARD_SIZE && y_tmp - 1 >= 0) {
-                x_tmp++;
-                y_tmp--;
-                p = dp_to_rf(x_tmp, y_tmp);
-                valid |= piece[p];
-                if (piece[p] & all_pieces) break;
-            }
-
-            x_tmp = x;
-            y_tmp = y;
-
-            // TL
-            while(x_tmp - 1 >= 0 && y_tmp - 1 >= 0) {
-                x_tmp--;
-                y_tmp--;
-                p = dp_to_rf(x_tmp, y_tmp);
-                valid |= piece[p];
-                if (piece[p] & all_pieces) break;
-            }
-
-            x_tmp = x;
-            y_tmp = y;
-
-            // BL
-            while(x_tmp - 1 >= 0 && y_tmp + 1 < BOARD_SIZE) {
-                x_tmp--;
-                y_tmp++;
-                p = dp_to_rf(x_tmp, y_tmp);
-                valid |= piece[p];
-                if (piece[p] & all_pieces) break;
-            }
-
-            x_tmp = x;
-            y_tmp = y;
-
-            // BR
-            while(x_tmp + 1 < BOARD_SIZE && y_tmp + 1 < BOARD_SIZE) {
-                x_tmp++;
-                y_tmp++;
-                p = dp_to_rf(x_tmp, y_tmp);
-                valid |= piece[p];
-                if (piece[p] & all_pieces) break;
-            }
-
-
-        }
-
-    }
-
-    return valid;
-
-}
-
-/* Set of squares a bishop can move to */
-uint64_t bishop_moveable(uint64_t bishop_loc, uint64_t own_side, uint64_t all_pieces) {
-    return bishop_attacked(bishop_loc, all_pieces) & ~own_side;
-}
-
-/* Set of squares attacked by a queen */
-uint64_t queen_attacked(uint64_t queen_loc, uint64_t all_pieces) {
-    return rook_attacked(queen_loc, all_pieces) | bishop_attacked(queen_loc, all_pieces);
-}
-
-/* Set of squares a queen can move to */
-uint64_t queen_moveable(uint64_t queen_loc, uint64_t own_side, uint64_t all_pieces) {
-    return queen_attacked(queen_loc, all_pieces) & ~own_side;
-}
-
-uint64_t compute_white_attacked_minus_black_king() {
-
-    // Non-sliders can be computed as usual
-    uint64_t pawns = white_pawn_attacked(bitboards[W_PAWN]);
-    uint64_t king = compute_king_incomplete(bitboards[W_KING], bitboards[W_ALL]);
-    uint64_t knights = knight_attacked(bitboards[W_KNIGHT]);
-
-    // Sliders must ignore the black king to invalidate moves away from slider attacks by black king
-    uint64_t black_minus_king = bitboards[B_ALL] & ~bitboards[B_KING];
-    uint64_t rooks = rook_attacked(bitboards[W_ROOK], bitboards[WB_ALL] & ~bitboards[B_KING]);
-    uint64_t bishops = bishop_attacked(bitboards[W_BISHOP], bitboards[WB_ALL] & ~bitboards[B_KING]);
-    uint64_t queens = queen_attacked(bitboards[W_QUEEN], bitboards[WB_ALL] & ~bitboards[B_KING]);
-
-    return pawns | king | knights | rooks | bishops | queens;
-
-}
-
-uint64_t compute_black_attacked_minus_white_king() {
-
-    // Non-sliders can be computed as usual
-    uint64_t pawns = black_pawn_attacked(bitboards[B_PAWN]);
-    uint64_t king = compute_king_incomplete(bitboards[B_KING], bitboards[B_ALL]);
-    uint64_t knights = knight_attacked(bitboards[B_KNIGHT]);
-
-    // Sliders must ignore the black king to invalidate moves away from slider attacks by black king
-    uint64_t white_minus_king = bitboards[W_ALL] & ~bitboards[W_KING];
-    uint64_t rooks = rook_attacked(bitboards[B_ROOK], bitboards[WB_ALL] & ~bitboards[W_KING]);
-    uint64_t bishops = bishop_attacked(bitboards[B_BISHOP], bitboards[WB_ALL] & ~bitboards[W_KING]);
-    uint64_t queens = queen_attacked(bitboards[B_QUEEN], bitboards[WB_ALL] & ~bitboards[W_KING]);
-
-    return pawns | king | knights | rooks | bishops | queens;
-
-}
-
-void is_white_checked(uint64_t king_loc, uint64_t* capture_mask, uint64_t* push_mask) {
-
-    *capture_mask = 0;
-    *push_mask = 0;
-
-    // Strategy: place enemy piece types on king position and see if they attack a real enemy piece
-    
-    // Pawns are a unique case as pawn attack direction is tightly coupled
-    // Check if king were a WHITE pawn, would it attack a BLACK pawn?
-    uint64_t pawn_move = white_pawn_attacked(king_loc);
-    *capture_mask |= pawn_move & bitboards[B_PAWN];
-    // Add en passant-ed square to attack set
-
-    // Knights
-    uint64_t knight_move = knight_attacked(king_loc);
-    *capture_mask |= knight_move & bitboards[B_KNIGHT];
-
-    // For sliding pieces, we must also calculate a push mask to block checks
-
-    // Bishops
-    uint64_t bishop_move = bishop_attacked(king_loc, bitboards[WB_ALL]);
-    *capture_mask |= bishop_move & bitboards[B_BISHOP];
-    // FIXME: Verify if this is correct?
-    *push_mask |= bishop_move & bishop_attacked(bitboards[B_BISHOP], bitboards[WB_ALL]) & ~bitboards[W_KING];
-
-    // Rooks
-    uint64_t rook_move = rook_attacked(king_loc, bitboards[WB_ALL]);
-    *capture_mask |= rook_move & bitboards[B_ROOK];
-    *push_mask |= rook_move & rook_attacked(bitboards[B_ROOK], bitboards[WB_ALL]) & ~bitboards[W_KING];
-
-    // Queens
-    uint64_t queen_move = queen_attacked(king_loc, bitboards[WB_ALL]);
-    *capture_mask |= queen_move & bitboards[B_QUEEN];
-    *push_mask |= queen_move & queen_attacked(bitboards[B_QUEEN], bitboards[WB_ALL]) & ~bitboards[W_KING];
-
-    // No need to check for kings as that's impossible.
-}
-
-void is_black_checked(uint64_t king_loc, uint64_t* capture_mask, uint64_t* push_mask) {
-
-    *capture_mask = 0;
-    *push_mask = 0;
-
-    // Strategy: place enemy piece types on king position and see if they attack a real enemy piece
-    
-    // Pawns are a unique case as pawn attack direction is tightly coupled
-    // Check if king were a BLACK pawn, would it attack a WHITE pawn?
-    uint64_t pawn_move = black_pawn_attacked(king_loc);
-    *capture_mask |= pawn_move & bitboards[W_PAWN];
-
-    // Knights
-    uint64_t knight_move = knight_attacked(king_loc);
-    *capture_mask |= knight_move & bitboards[W_KNIGHT];
-
-    // For sliding pieces, we must also calculate a push mask to block checks
-
-    // Bishops
-    uint64_t bishop_move = bishop_attacked(king_loc, bitboards[WB_ALL]);
-    *capture_mask |= bishop_move & bitboards[W_BISHOP];
-    *push_mask |= bishop_move & bishop_attacked(bitboards[W_BISHOP], bitboards[WB_ALL]) & ~bitboards[B_KING];
-
-    // Rooks
-    uint64_t rook_move = rook_attacked(king_loc, bitboards[WB_ALL]);
-    *capture_mask |= rook_move & bitboards[W_ROOK];
-    // Set bits BETWEEN the rook and king. Take conjunction of rook moves from both positions!
-    *push_mask |= rook_move & rook_attacked(bitboards[W_ROOK], bitboards[WB_ALL]) & ~bitboards[B_KING];
-
-    // Queens
-    uint64_t queen_move = queen_attacked(king_loc, bitboards[WB_ALL]);
-    *capture_mask |= queen_move & bitboards[W_QUEEN];
-    *push_mask |= queen_move & queen_attacked(bitboards[W_QUEEN], bitboards[WB_ALL]) & ~bitboards[B_KING];
-
-}
-
-void move_piece(uint64_t p, uint64_t q, uint8_t px, uint8_t py, uint8_t qx, uint8_t qy, uint8_t own_side, uint8_t enemy_side) {
-
-    // Moving piece type
-    uint8_t t = board[px][py];
-
-    // Destination piece type
-    uint8_t u = board[qx][qy];
-
-    // Update castling rights
-    if (t == W_KING) {
-        castle_flags &= ~(1 << CASTLE_WHITE_KINGSIDE) | ~(1 << CASTLE_WHITE_QUEENSIDE);
-    } else if (t == B_KING) {
-        castle_flags &= ~(1 << CASTLE_BLACK_KINGSIDE) | ~(1 << CASTLE_BLACK_QUEENSIDE);
-    } else if ( (t == W_ROOK && p == WHITE_KINGSIDE_ROOK) || (u == W_ROOK && q == WHITE_KINGSIDE_ROOK) ) {
-        castle_flags &= ~(1 << CASTLE_WHITE_KINGSIDE);
-    } else if ( (t == W_ROOK && p == WHITE_QUEENSIDE_ROOK) || (u == W_ROOK && q == WHITE_QUEENSIDE_ROOK) ) {
-        castle_flags &= ~(1 << CASTLE_WHITE_QUEENSIDE);
-    } else if ( (t == B_ROOK && p == BLACK_KINGSIDE_ROOK) || (u == B_ROOK && q == BLACK_KINGSIDE_ROOK) ) {
-        castle_flags &= ~(1 << CASTLE_BLACK_KINGSIDE);
-    } else if ( (t == B_ROOK && p == BLACK_QUEENSIDE_ROOK) || (u == B_ROOK && q == BLACK_QUEENSIDE_ROOK) ) {
-        castle_flags &= ~(1 << CASTLE_BLACK_QUEENSIDE);
-    }
-    
-    // Did an en-passant just happen? Holy hell.
-    // Check if pawn destination is a diagonal and ensure it is empty to confirm en passant.
-    if ( (t == W_PAWN) && (((p << 7) & q) | ((p << 9) & q)) && !(q & bitboards[WB_ALL]) ) {
-        remove_piece(q >> 8, qx, qy + 1);
-    } else if ( (t == B_PAWN) && (((p >> 7) & q) | ((p >> 9) & q)) && !(q & bitboards[WB_ALL]) ) {
-        remove_piece(q << 8, qx, qy - 1);
-    }
-
-    // Unset current position of moving piece
-    bitboards[t] &= ~p;
-    // Set new position of moving piece
-    bitboards[t] |= q;
-
-    // Remove taken piece
-    bitboards[u] &= ~q;
-    bitboards[enemy_side] &= ~q;
-
-    // Update own side bitboard
-    bitboards[own_side] &= ~p;
-    bitboards[own_side] |= q;
-
-    // Update all piece bitboard
-    bitboards[WB_ALL] = bitboards[own_side] | bitboards[enemy_side];
-
-    // Update lookup table
-    board[px][py] = EMPTY;
-    board[qx][qy] = t;
-
-}
-
-void remove_piece(uint64_t piece_loc, uint8_t x, uint8_t y) {
-    bitboards[B_PAWN] &= ~piece_loc;
-    bitboards[W_PAWN] &= ~piece_loc;
-    bitboards[B_ALL] &= ~piece_loc;
-    bitboards[W_ALL] &= ~piece_loc;
-    board[x][y] = EMPTY;
-    uint16_t col = ((x + y) & 1) ? DK_SQ_COL : LT_SQ_COL;
-    draw_square(x, y, col);
-}
-
-uint64_t castle_set_white() {
-
-    uint64_t castle_set = 0;
-
-    uint64_t attacked = compute_black_attacked_minus_white_king();
-
-    uint64_t kingside_attacked = (piece[4] | piece[5] | piece[6]) & attacked;
-    uint64_t queenside_attacked = (piece[4] | piece[3] | piece[2]) & attacked;
-
-    if (castle_flags & (1 << CASTLE_WHITE_KINGSIDE) && kingside_attacked == 0) {
-
-        // Check ray from king to rook
-        uint64_t hray = rook_attacked(WHITE_KING_INITIAL, bitboards[WB_ALL]);
-
-        if (hray & WHITE_KINGSIDE_ROOK)
-            castle_set |= WHITE_KINGSIDE_ROOK;
-    }
-
-    if (castle_flags & (1 << CASTLE_WHITE_QUEENSIDE) && queenside_attacked == 0) {
-
-        // Check ray from king to rook
-        uint64_t hray = rook_attacked(WHITE_KING_INITIAL, bitboards[WB_ALL]);
-
-        if (hray & WHITE_QUEENSIDE_ROOK)
-            castle_set |= WHITE_QUEENSIDE_ROOK;
-    }
-
-    return castle_set;
-
-}
-
-
-uint64_t castle_set_black() {
-
-    uint64_t castle_set = 0;
-    uint64_t one = 1;
-
-    uint64_t attacked = compute_white_attacked_minus_black_king();
-
-    uint64_t kingside_attacked = (piece[60] | piece[61] | piece[62]) & attacked;
-    uint64_t queenside_attacked = (piece[60] | piece[59] | piece[58]) & attacked;
-
-    if (castle_flags & (1 << CASTLE_BLACK_KINGSIDE) && kingside_attacked == 0) {
-
-        // Check ray from king to rook
-        uint64_t hray = rook_attacked(BLACK_KING_INITIAL, bitboards[WB_ALL]);
-
-        if (hray & BLACK_KINGSIDE_ROOK)
-            castle_set |= BLACK_KINGSIDE_ROOK;
-    }
-
-    if (castle_flags & (1 << CASTLE_BLACK_QUEENSIDE) && queenside_attacked == 0) {
-
-        uint64_t hray = rook_attacked(BLACK_KING_INITIAL, bitboards[WB_ALL]);
-        
-        if (hray & BLACK_QUEENSIDE_ROOK)
-            castle_set |= BLACK_QUEENSIDE_ROOK;
-    }
-
-    return castle_set;
-
-}
-
-void castle(uint64_t castle_square) {
-
-    uint64_t king_initial;
-    uint64_t king_castled;
-    uint64_t rook_initial;
-    uint64_t rook_castled;
-
-    uint8_t side;
-    uint8_t king;
-    uint8_t rook;
-
-    uint8_t x_start, x_end;
-    uint8_t y;
-
-    if (castle_square & WHITE_KINGSIDE_ROOK) {
-
-        // Set initialisation variables
-        king_initial = WHITE_KING_INITIAL;
-        king_castled = WHITE_KINGSIDE_KING_CASTLED;
-        rook_initial = WHITE_KINGSIDE_ROOK;
-        rook_castled = WHITE_KINGSIDE_ROOK_CASTLED;
-        side = W_ALL;
-        king = W_KING;
-        rook = W_ROOK;
-
-        // Update flags
-        castle_flags &= ~(1 << CASTLE_WHITE_KINGSIDE);
-        castle_flags &= ~(1 << CASTLE_WHITE_QUEENSIDE);
-
-        // Update display representation
-        board[4][7] = EMPTY;
-        board[7][7] = EMPTY;
-        board[6][7] = W_KING;
-        board[5][7] = W_ROOK;
-
-        x_start = 4;
-        x_end = 7;
-        y = 7;
-
-    } else if (castle_square & WHITE_QUEENSIDE_ROOK) {
-
-        king_initial = WHITE_KING_INITIAL;
-        king_castled = WHITE_QUEENSIDE_KING_CASTLED;
-        rook_initial = WHITE_QUEENSIDE_ROOK;
-        rook_castled = WHITE_QUEENSIDE_ROOK_CASTLED;
-        side = W_ALL;
-        king = W_KING;
-        rook = W_ROOK;
-
-        castle_flags &= ~(1 << CASTLE_WHITE_KINGSIDE);
-        castle_flags &= ~(1 << CASTLE_WHITE_QUEENSIDE);
-
-        board[4][7] = EMPTY;
-        board[0][7] = EMPTY;
-        board[2][7] = W_KING;
-        board[3][7] = W_ROOK;
-
-        x_start = 0;
-        x_end = 4;
-        y = 7;
-
-    } else if (castle_square & BLACK_KINGSIDE_ROOK) {
-
-        king_initial = BLACK_KING_INITIAL;
-        king_castled = BLACK_KINGSIDE_KING_CASTLED;
-        rook_initial = BLACK_KINGSIDE_ROOK;
-        rook_castled = BLACK_KINGSIDE_ROOK_CASTLED;
-        side = B_ALL;
-        king = B_KING;
-        rook = B_ROOK;
-
-        castle_flags &= ~(1 << CASTLE_BLACK_KINGSIDE);
-        castle_flags &= ~(1 << CASTLE_BLACK_QUEENSIDE);
-
-        board[4][0] = EMPTY;
-        board[7][0] = EMPTY;
-        board[6][0] = B_KING;
-        board[5][0] = B_ROOK;
-
-        x_start = 4;
-        x_end = 7;
-        y = 0;
-
-    } else if (castle_square & BLACK_QUEENSIDE_ROOK) {
-
-        king_initial = BLACK_KING_INITIAL;
-        king_castled = BLACK_QUEENSIDE_KING_CASTLED;
-        rook_initial = BLACK_QUEENSIDE_ROOK;
-        rook_castled = BLACK_QUEENSIDE_ROOK_CASTLED;
-        side = B_ALL;
-        king = B_KING;
-        rook = B_ROOK;
-
-        castle_flags &= ~(1 << CASTLE_BLACK_KINGSIDE);
-        castle_flags &= ~(1 << CASTLE_BLACK_QUEENSIDE);
-
-        board[4][0] = EMPTY;
-        board[0][0] = EMPTY;
-        board[2][0] = B_KING;
-        board[3][0] = B_ROOK;
-
-        x_start = 0;
-        x_end = 4;
-        y = 0;
-
-    }
-#ifdef DEBUG
-    else {
-        // SHOULDN'T HAPPEN
-        debug_bitboard(ERROR_ERRONEOUS_CASTLE_CALL);
-        return;
-    }
-#endif
-
-    // Move king
-    bitboards[king] = king_castled;
-    
-    // Move rook
-    bitboards[rook] &= ~rook_initial;
-    bitboards[rook] |= rook_castled;
-
-    // Update side board
-    bitboards[side] &= ~king_initial & ~rook_initial;
-    bitboards[side] |= king_castled | rook_castled;
-
-    // Update global board
-    bitboards[WB_ALL] = bitboards[W_ALL] | bitboards[B_ALL];
-
-    // Redraw squares
-    for (uint8_t k = x_start; k <= x_end; k++) {
-        uint16_t col = ((k + y) & 1) ? DK_SQ_COL : LT_SQ_COL;
-        draw_square(k, y, col);
-        draw_piece(k, y);
-    }
-
-}
-
-// Comptue pin mask assuming enemy is black
-uint64_t compute_pin_mask_white(uint64_t piece) {
-
-    // Compute all sliding enemy moves + pawns and determine if rays
-    // ever intersect with same move from king position.
-    // Then, if the overlap contains the piece in quesiton, it is pinned.
-    // The overlapping ray is then the pin mask.
-
-    // ASSUMPTION: Pieces can't be double-pinned to the king right?
-    // I can't think of a way this is possible. If I'm wrong, then this is broken.
-
-    // TODO: Each pin should include position of attacking piece as well
-    // so it can be taken
-
-    uint64_t pin_mask = 0;
-    uint64_t capture_mask = 0;
-
-    uint64_t white_excluded = bitboards[W_ALL] & ~piece;
-
-    // P
-    // TODO: Check if this needs to use excluded white like the others.
-    uint64_t p = black_pawn_moveable(bitboards[B_PAWN]);
-    uint64_t p_from_k = white_pawn_moveable(bitboards[W_KING]);
-    if (piece & p & p_from_k) {
-        pin_mask |= ~piece & p & p_from_k;
-        capture_mask |= p_from_k & bitboards[B_PAWN];
-        return pin_mask | capture_mask;
-    }
-
-    // B
-    uint64_t b = bishop_attacked(bitboards[B_BISHOP], bitboards[WB_ALL] & ~piece);
-    uint64_t b_from_k = bishop_attacked(bitboards[W_KING], bitboards[WB_ALL] & ~piece);
-    if (piece & b & b_from_k) {
-        pin_mask |= ~piece & b & b_from_k;
-        capture_mask |= b_from_k & bitboards[B_BISHOP];
-        return pin_mask | capture_mask;
-    }
-
-    // R
-    uint64_t r = rook_attacked(bitboards[B_ROOK], bitboards[WB_ALL] & ~piece);
-    uint64_t r_from_k = rook_attacked(bitboards[W_KING], bitboards[WB_ALL] & ~piece);
-    if (piece & r & r_from_k) {
-        pin_mask |= ~piece & r & r_from_k;
-        capture_mask |= r_from_k & bitboards[B_ROOK];
-        return pin_mask | capture_mask;
-    }
-
-    // Queen diagonals
-    uint64_t qd = bishop_attacked(bitboards[B_QUEEN], bitboards[WB_ALL] & ~piece);
-    uint64_t qd_from_k = bishop_attacked(bitboards[W_KING], bitboards[WB_ALL] & ~piece);
-    if (piece & qd & qd_from_k) {
-        pin_mask |= qd & qd_from_k & ~piece;
-        capture_mask |= qd_from_k & bitboards[B_QUEEN];
-        return pin_mask | capture_mask;
-    }
-
-    // Queen non-diagonals
-    uint64_t qn = rook_attacked(bitboards[B_QUEEN], bitboards[WB_ALL] & ~piece);
-    uint64_t qn_from_k = rook_attacked(bitboards[W_KING], bitboards[WB_ALL] & ~piece);
-    if (piece & qn & qn_from_k) {
-        pin_mask |= ~piece & qn & qn_from_k;
-        capture_mask |= qn_from_k & bitboards[B_QUEEN];
-        return pin_mask | capture_mask;
-    }
-
-    // ASSUMPTION 2: There is no need to compute for a queen again here, this case is covered
-    // by rook and bishops computations above.
-
-    // // Q
-    // uint64_t q = compute_queen(bitboards[B_QUEEN], bitboards[B_ALL], white_excluded);
-    // uint64_t q_from_k = compute_queen(bitboards[W_KING], white_excluded, bitboards[B_ALL]);
-    // if (piece & q & q_from_k) {
-    //     pin_mask |= q & q_from_k;
-    //     return pin_mask;
-    // }
-    
-
-    return ~pin_mask;
-
-}
-
-// Comptue pin mask assuming enemy is white
-uint64_t compute_pin_mask_black(uint64_t piece) {
-
-    // Compute all sliding enemy moves + pawns and determine if rays
-    // ever intersect with same move from king position.
-    // Then, if the overlap contains the piece in quesiton, it is pinned.
-    // The overlapping ray is then the pin mask.
-
-    uint64_t pin_mask = 0;
-    uint64_t capture_mask = 0;
-
-    uint64_t black_excluded = bitboards[B_ALL] & ~piece;
-
-    // P
-    // TODO: Check if this needs to use excluded white like the others.
-    uint64_t p = white_pawn_moveable(bitboards[W_PAWN]);
-    uint64_t p_from_k = black_pawn_moveable(bitboards[B_KING]);
-    if (piece & p & p_from_k) {
-        pin_mask |= ~piece & p & p_from_k;
-        capture_mask |= p_from_k & bitboards[W_PAWN];
-        return pin_mask | capture_mask;
-    }
-
-
-    // B
-    uint64_t b = bishop_attacked(bitboards[W_BISHOP], bitboards[WB_ALL] & ~piece);
-    uint64_t b_from_k = bishop_attacked(bitboards[B_KING], bitboards[WB_ALL] & ~piece);
-    if (piece & b & b_from_k) {
-        pin_mask |= ~piece & b & b_from_k;
-        capture_mask |= b_from_k & bitboards[W_BISHOP];
-        return pin_mask | capture_mask;
-    }
-    
-
-    // R
-    uint64_t r = rook_attacked(bitboards[W_ROOK], bitboards[WB_ALL] & ~piece);
-    uint64_t r_from_k = rook_attacked(bitboards[B_KING], bitboards[WB_ALL] & ~piece);
-    if (piece & r & r_from_k) {
-        pin_mask |= ~piece & r & r_from_k;
-        capture_mask |= r_from_k & bitboards[W_ROOK];
-        return pin_mask | capture_mask;
-    }
-
-    // Queen diagonals
-    uint64_t qd = bishop_attacked(bitboards[W_QUEEN], bitboards[WB_ALL] & ~piece);
-    uint64_t qd_from_k = bishop_attacked(bitboards[B_KING], bitboards[WB_ALL] & ~piece);
-    if (piece & qd & qd_from_k) {
-        pin_mask |= qd & qd_from_k & ~piece;
-        capture_mask |= qd_from_k & bitboards[W_QUEEN];
-        return pin_mask | capture_mask;
-    }
-
-    // Queen non-diagonals
-    uint64_t qn = rook_attacked(bitboards[W_QUEEN], bitboards[WB_ALL] & ~piece);
-    uint64_t qn_from_k = rook_attacked(bitboards[B_KING], bitboards[WB_ALL] & ~piece);
-    if (piece & qn & qn_from_k) {
-        pin_mask |= ~piece & qn & qn_from_k;
-        capture_mask |= qn_from_k & bitboards[W_QUEEN];
-        return pin_mask | capture_mask;
-    }
-    
-
-    // // Q
-    // uint64_t q = compute_queen(bitboards[W_QUEEN], bitboards[W_ALL], black_excluded);
-    // uint64_t q_from_k = compute_queen(bitboards[B_KING], black_excluded, bitboards[W_ALL]);
-    // if (piece & q & q_from_k) {
-    //     pin_mask |= q & q_from_k;
-    //     return pin_mask;
-    // }
-    
-
-    return ~pin_mask;
-
-}
\ No newline at end of file
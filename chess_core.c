@@ -0,0 +1,1857 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "chess_core.h"
+#include "bits.h"
+#include "shifts.h"
+#include "leaper_tables.h"
+#include "zobrist_keys.h"
+#include "pst_tables.h"
+
+/* Side-parameterized rules code
+ *
+ * Check, pin, castling and move mask rules are written once with the side as a
+ * parameter, and the white and black entry points call them with a constant.
+ * On the host each body is inlined into both, so the side tests fold away and
+ * each colour gets its own branch-free path. On the device one shared body is
+ * kept for both, for half the flash.
+ */
+#ifdef __AVR__
+#define SIDE_SPECIALISED static
+#else
+#define SIDE_SPECIALISED static inline __attribute__((always_inline))
+#endif
+
+/* Castling */
+
+const uint64_t WHITE_KING_INITIAL = 0x10;
+
+const uint64_t WHITE_KINGSIDE_ROOK =  0x80;
+const uint64_t WHITE_KINGSIDE_ROOK_CASTLED = 0x20;
+const uint64_t WHITE_KINGSIDE_KING_CASTLED = 0x40;
+
+const uint64_t WHITE_QUEENSIDE_ROOK = 0x1;
+const uint64_t WHITE_QUEENSIDE_ROOK_CASTLED = 0x8;
+const uint64_t WHITE_QUEENSIDE_KING_CASTLED = 0x4;
+
+const uint64_t BLACK_KING_INITIAL = 0x1000000000000000;
+
+const uint64_t BLACK_KINGSIDE_ROOK =         0x8000000000000000;
+const uint64_t BLACK_KINGSIDE_ROOK_CASTLED = 0x2000000000000000;
+const uint64_t BLACK_KINGSIDE_KING_CASTLED = 0x4000000000000000;
+
+const uint64_t BLACK_QUEENSIDE_ROOK =         0x0100000000000000;
+const uint64_t BLACK_QUEENSIDE_ROOK_CASTLED = 0x0800000000000000;
+const uint64_t BLACK_QUEENSIDE_KING_CASTLED = 0x0400000000000000;
+
+/* En passant */
+
+// Square skipped by the last move if it was a double pawn step that an enemy pawn can take
+uint8_t ep_square = NO_SQUARE;
+
+// Side to move
+uint8_t current_player = PLAYER_WHITE;
+
+// Capture castling flags in a byte variable using enums above for indexing
+uint8_t castle_flags = 0x0F;
+
+// Zobrist key of the position, kept up to date by everything that changes it
+uint64_t hash_key = 0;
+
+// Zobrist key of the pawns alone, for the pawn structure table
+uint64_t pawn_key = 0;
+
+// Material and piece-square score (white less black) for the middlegame and
+// the endgame, and the game phase to blend them by, kept up to date alike
+int16_t score_mg = 0;
+int16_t score_eg = 0;
+uint8_t score_phase = 0;
+
+// Piece type lookup table and visual representation
+// Note: indexed as [X][Y] NOT [ROW][COL] where (0,0) is top left
+// Right is +x, Down is +y
+uint8_t board[BOARD_SIZE][BOARD_SIZE];
+
+// Bitboards for efficient computation
+// One per piece type, then the white, black and combined occupancy (EMPTY is a scratch slot)
+uint64_t bitboards[WB_ALL + 1];
+
+// Bitboards with only rank-file index bit set
+uint64_t piece[BOARD_SIZE * BOARD_SIZE];
+
+// Squares attacked by each side, kept up to date by the piece movement functions.
+// Changes are collected and applied on the next read (see get_attacks).
+static attack_map attacks[2];
+static uint64_t pending_squares = 0;
+static uint16_t pending_types = 0;
+
+// Squares whose contents changed since the display last took them (see take_changed_squares)
+static uint64_t changed_squares = 0;
+
+/* Lookup tables */
+
+const uint64_t clear_rank[BOARD_SIZE] = {
+    0xFFFFFFFFFFFFFF00,
+    0xFFFFFFFFFFFF00FF,
+    0xFFFFFFFFFF00FFFF,
+    0xFFFFFFFF00FFFFFF,
+    0xFFFFFF00FFFFFFFF,
+    0xFFFF00FFFFFFFFFF,
+    0xFF00FFFFFFFFFFFF,
+    0x00FFFFFFFFFFFFFF
+};
+
+
+const uint64_t mask_rank[BOARD_SIZE] = {
+    0x00000000000000FF,
+    0x000000000000FF00,
+    0x0000000000FF0000,
+    0x00000000FF000000,
+    0x000000FF00000000,
+    0x0000FF0000000000,
+    0x00FF000000000000,
+    0xFF00000000000000
+};
+
+const uint64_t clear_file[BOARD_SIZE] = {
+    0xFEFEFEFEFEFEFEFE,
+    0xFDFDFDFDFDFDFDFD,
+    0xFBFBFBFBFBFBFBFB,
+    0xF7F7F7F7F7F7F7F7,
+    0xEFEFEFEFEFEFEFEF,
+    0xDFDFDFDFDFDFDFDF,
+    0xBFBFBFBFBFBFBFBF,
+    0x7F7F7F7F7F7F7F7F
+};
+
+const uint64_t mask_file[BOARD_SIZE] = {
+    0x0101010101010101,
+    0x0202020202020202,
+    0x0404040404040404,
+    0x0808080808080808,
+    0x1010101010101010,
+    0x2020202020202020,
+    0x4040404040404040,
+    0x8080808080808080
+};
+
+/* Initialises the board from a 64 character representation */
+void init_board(const char* board_rep) {
+
+    init_sliders();
+
+    uint64_t ONE_64 = 1;
+
+    uint8_t i = 0;
+    uint8_t x = 0;
+    uint8_t y = 0;
+    while (board_rep[i]) {
+
+        uint8_t j = dp_to_rf(x, y);
+
+        switch (board_rep[i]) {
+
+            case 'P':
+                bitboards[W_PAWN] |= ONE_64 << j;
+                board[x][y] = W_PAWN;
+                break;
+            case 'R':
+                bitboards[W_ROOK] |= ONE_64 << j;
+                board[x][y] = W_ROOK;
+                break;
+            case 'N':
+                bitboards[W_KNIGHT] |= ONE_64 << j;
+                board[x][y] = W_KNIGHT;
+                break;
+            case 'B':
+                bitboards[W_BISHOP] |= ONE_64 << j;
+                board[x][y] = W_BISHOP;
+                break;
+            case 'Q':
+                bitboards[W_QUEEN] |= ONE_64 << j;
+                board[x][y] = W_QUEEN;
+                break;
+            case 'K':
+                bitboards[W_KING] |= ONE_64 << j;
+                board[x][y] = W_KING;
+                break;
+
+            case 'p':
+                bitboards[B_PAWN] |= ONE_64 << j;
+                board[x][y] = B_PAWN;
+                break;
+            case 'r':
+                bitboards[B_ROOK] |= ONE_64 << j;
+                board[x][y] = B_ROOK;
+                break;
+            case 'n':
+                bitboards[B_KNIGHT] |= ONE_64 << j;
+                board[x][y] = B_KNIGHT;
+                break;
+            case 'b':
+                bitboards[B_BISHOP] |= ONE_64 << j;
+                board[x][y] = B_BISHOP;
+                break;
+            case 'q':
+                bitboards[B_QUEEN] |= ONE_64 << j;
+                board[x][y] = B_QUEEN;
+                break;
+            case 'k':
+                bitboards[B_KING] |= ONE_64 << j;
+                board[x][y] = B_KING;
+                break;
+
+            default:
+                break;
+
+        }
+
+        if (x + 1 >= BOARD_SIZE) {
+            x = 0;
+            y++;
+        } else {
+            x++;
+        }
+        
+        i++;
+    }
+
+    // All bitboards (remember to keep these updated!)
+    bitboards[W_ALL] = bitboards[W_PAWN] | bitboards[W_ROOK] | bitboards[W_KNIGHT] | bitboards[W_BISHOP] | bitboards[W_QUEEN] | bitboards[W_KING];
+    bitboards[B_ALL] = bitboards[B_PAWN] | bitboards[B_ROOK] | bitboards[B_KNIGHT] | bitboards[B_BISHOP] | bitboards[B_QUEEN] | bitboards[B_KING];
+    bitboards[WB_ALL] = bitboards[W_ALL] | bitboards[B_ALL];
+
+    for (uint64_t i = 0; i < BOARD_SIZE * BOARD_SIZE; i++) {
+        uint64_t one = 1;
+        piece[i] = one << i;
+    }
+
+    init_attacks();
+    reset_check_info();
+
+    // Whoever sets up a board redraws all of it
+    changed_squares = 0;
+
+    hash_key = compute_hash_key();
+    pawn_key = compute_pawn_key();
+    compute_score(&score_mg, &score_eg, &score_phase);
+
+
+    // /* Setup bitboards */
+
+    // // RIGHT shift is towards LSB and is equivalent to moving a piece LEFT.
+    // // White pieces are nearest LSB.
+    // // See mapping: http://pages.cs.wisc.edu/~psilord/blog/data/chess-pages/rep.html
+
+    // const uint64_t pawns = 0x0000;
+    // // const uint64_t pawns = 0xFF00;
+    // const uint64_t rooks = 0x81;
+    // const uint64_t knights = 0x00;
+    // // const uint64_t knights = 0x42;
+    // const uint64_t bishops = 0x24;
+    // const uint64_t queens = 0x8;
+    // const uint64_t kings = 0x10;
+
+    // // White bitboards
+    // bitboards[W_PAWN] =   pawns;
+    // bitboards[W_ROOK] =   rooks;
+    // bitboards[W_KNIGHT] = knights;
+    // bitboards[W_BISHOP] = bishops;
+    // bitboards[W_QUEEN] =  queens;
+    // bitboards[W_KING] =   kings;
+
+    // // Black bitboards
+    // bitboards[B_PAWN] =   pawns << 40;
+    // bitboards[B_ROOK] =   rooks << 56;
+    // bitboards[B_KNIGHT] = knights << 56;
+    // bitboards[B_BISHOP] = bishops << 56;
+    // bitboards[B_QUEEN] =  queens << 56;
+    // bitboards[B_KING] =   kings << 56;
+
+    // // All bitboards (remember to keep these updated!)
+    // bitboards[W_ALL] = bitboards[W_PAWN] | bitboards[W_ROOK] | bitboards[W_KNIGHT] | bitboards[W_BISHOP] | bitboards[W_QUEEN] | bitboards[W_KING];
+    // bitboards[B_ALL] = bitboards[B_PAWN] | bitboards[B_ROOK] | bitboards[B_KNIGHT] | bitboards[B_BISHOP] | bitboards[B_QUEEN] | bitboards[B_KING];
+    // bitboards[WB_ALL] = bitboards[W_ALL] | bitboards[B_ALL];
+
+    // for (uint64_t i = 0; i < BOARD_SIZE * BOARD_SIZE; i++) {
+    //     uint64_t one = 1;
+    //     piece[i] = one << i;
+    // }
+
+    // // debug_bitboard(piece[28]);
+
+    // /* Setup display board */
+
+    // // Clear board
+    // memset(board, EMPTY, sizeof(board));
+
+    // // Pawns
+    // uint8_t i;
+    // for (i = 0; i < BOARD_SIZE; i++) {
+    //     board[i][1] = B_PAWN;
+    //     board[i][6] = W_PAWN;
+    // }
+
+    // // Black pieces
+    // board[0][0] = B_ROOK;
+    // board[1][0] = B_KNIGHT;
+    // board[2][0] = B_BISHOP;
+    // board[3][0] = B_QUEEN;
+    // board[4][0] = B_KING;
+    // board[5][0] = B_BISHOP;
+    // board[6][0] = B_KNIGHT;
+    // board[7][0] = B_ROOK;
+
+    // // White pieces
+    // board[0][7] = W_ROOK;
+    // board[1][7] = W_KNIGHT;
+    // board[2][7] = W_BISHOP;
+    // board[3][7] = W_QUEEN;
+    // board[4][7] = W_KING;
+    // board[5][7] = W_BISHOP;
+    // board[6][7] = W_KNIGHT;
+    // board[7][7] = W_ROOK;
+
+}
+
+
+/* Sets up the game from a FEN record (placement, side, castling, en passant) */
+uint8_t load_fen(const char* fen) {
+
+    char board_rep[BOARD_SIZE * BOARD_SIZE + 1];
+    uint8_t n = 0;
+
+    // Expand the placement field into the 64 character representation
+    for (; *fen && *fen != ' '; fen++) {
+        if (*fen == '/') continue;
+        if (*fen >= '1' && *fen <= '8') {
+            for (uint8_t k = 0; k < *fen - '0' && n < BOARD_SIZE * BOARD_SIZE; k++) {
+                board_rep[n++] = '.';
+            }
+        } else if (n < BOARD_SIZE * BOARD_SIZE) {
+            board_rep[n++] = *fen;
+        } else {
+            return 0;
+        }
+    }
+    if (n != BOARD_SIZE * BOARD_SIZE) return 0;
+    board_rep[n] = '\0';
+
+    memset(bitboards, 0, sizeof(bitboards));
+    memset(board, EMPTY, sizeof(board));
+    init_board(board_rep);
+
+    // Side to move
+    while (*fen == ' ') fen++;
+    current_player = (*fen == 'b') ? PLAYER_BLACK : PLAYER_WHITE;
+    if (*fen) fen++;
+
+    // Castling rights
+    while (*fen == ' ') fen++;
+    castle_flags = 0;
+    for (; *fen && *fen != ' '; fen++) {
+        switch (*fen) {
+            case 'K': castle_flags |= 1 << CASTLE_WHITE_KINGSIDE; break;
+            case 'Q': castle_flags |= 1 << CASTLE_WHITE_QUEENSIDE; break;
+            case 'k': castle_flags |= 1 << CASTLE_BLACK_KINGSIDE; break;
+            case 'q': castle_flags |= 1 << CASTLE_BLACK_QUEENSIDE; break;
+            default: break;
+        }
+    }
+
+    // En passant target square, kept only if a pawn can actually take (as after apply_move)
+    while (*fen == ' ') fen++;
+    ep_square = NO_SQUARE;
+    if (fen[0] >= 'a' && fen[0] <= 'h' && (fen[1] == '3' || fen[1] == '6')) {
+        uint8_t target = (fen[0] - 'a') + (fen[1] - '1') * BOARD_SIZE;
+        uint64_t takers = (current_player == PLAYER_WHITE) ? black_pawn_attacked(piece[target]) & bitboards[W_PAWN]
+                                                           : white_pawn_attacked(piece[target]) & bitboards[B_PAWN];
+        if (takers) ep_square = target;
+    }
+
+    hash_key = compute_hash_key();
+    pawn_key = compute_pawn_key();
+    compute_score(&score_mg, &score_eg, &score_phase);
+
+    return 1;
+}
+
+/* Plays a move picked as from/to rank-file indexes, then hands over the turn */
+uint8_t play_move(uint8_t rf_from, uint8_t rf_to) {
+
+    uint64_t p = piece[rf_from];
+    uint64_t q = piece[rf_to];
+
+    // Castling is picked as king onto rook or rook onto king
+    if ( ( ( bitboards[W_KING] & p ) && ( bitboards[W_ROOK] & q ) ) ||
+         ( ( bitboards[B_KING] & p ) && ( bitboards[B_ROOK] & q ) ) ) {
+        return apply_move((rf_to > rf_from) ? MOVE(rf_from, rf_from + 2, MOVE_CASTLE_KINGSIDE)
+                                            : MOVE(rf_from, rf_from - 2, MOVE_CASTLE_QUEENSIDE));
+    }
+    if ( ( ( bitboards[W_ROOK] & p ) && ( bitboards[W_KING] & q ) ) ||
+         ( ( bitboards[B_ROOK] & p ) && ( bitboards[B_KING] & q ) ) ) {
+        return apply_move((rf_from > rf_to) ? MOVE(rf_to, rf_to + 2, MOVE_CASTLE_KINGSIDE)
+                                            : MOVE(rf_to, rf_to - 2, MOVE_CASTLE_QUEENSIDE));
+    }
+
+    uint8_t px, py, qx, qy;
+    rf_to_dp(rf_from, &px, &py);
+    rf_to_dp(rf_to, &qx, &qy);
+
+    uint8_t ty = board[px][py];
+    uint8_t flag = (board[qx][qy] != EMPTY) ? MOVE_CAPTURE : MOVE_QUIET;
+
+    if (ty == W_PAWN || ty == B_PAWN) {
+        if (px != qx && board[qx][qy] == EMPTY) {
+            // A pawn moving diagonally onto an empty square takes en passant
+            flag = MOVE_EN_PASSANT;
+        } else if (qy == 0 || qy == BOARD_SIZE - 1) {
+            // There is no piece picker on the LCD, so always promote to a queen
+            flag |= MOVE_PROMOTION | PROMOTE_QUEEN;
+        } else if (rf_to == rf_from + 2 * BOARD_SIZE || rf_from == rf_to + 2 * BOARD_SIZE) {
+            flag = MOVE_DOUBLE_PUSH;
+        }
+    }
+
+    return apply_move(MOVE(rf_from, rf_to, flag));
+}
+
+uint64_t generate_moves(uint64_t piece_loc, uint8_t piece_type) {
+    switch(piece_type) {
+
+        case EMPTY:
+
+            // OK, Idiot.
+
+            return 0;
+        
+
+        case B_KING:
+
+            return (compute_king_incomplete(piece_loc, bitboards[B_ALL]) &
+                            ~compute_white_attacked_minus_black_king()) |
+                            castle_set_black();
+            break;
+
+
+        case W_KING:
+
+            return (compute_king_incomplete(piece_loc, bitboards[W_ALL]) &
+                            ~compute_black_attacked_minus_white_king()) |
+                            castle_set_white();
+            break;
+
+
+        case B_KNIGHT:
+
+            return knight_moveable(piece_loc, bitboards[B_ALL]) & masks_black(piece_loc);
+
+            break;
+
+
+        case W_KNIGHT:
+
+            return knight_moveable(piece_loc, bitboards[W_ALL]) & masks_white(piece_loc);
+
+            break;
+
+
+        case B_PAWN:
+
+            return black_pawn_moveable(piece_loc) & masks_black(piece_loc);
+
+            break;
+
+        case W_PAWN:
+
+            return white_pawn_moveable(piece_loc) & masks_white(piece_loc);
+
+            break;
+
+        case B_ROOK:
+
+            return rook_moveable(piece_loc, bitboards[B_ALL], bitboards[WB_ALL]) & masks_black(piece_loc);
+
+            break;
+
+        case W_ROOK:
+
+            return rook_moveable(piece_loc, bitboards[W_ALL], bitboards[WB_ALL]) & masks_white(piece_loc);
+
+            break;
+
+        case B_BISHOP:
+
+            return bishop_moveable(piece_loc, bitboards[B_ALL], bitboards[WB_ALL]) & masks_black(piece_loc);
+
+            break;
+
+        case W_BISHOP:
+
+            return bishop_moveable(piece_loc, bitboards[W_ALL], bitboards[WB_ALL]) & masks_white(piece_loc);
+
+            break;
+
+        case B_QUEEN:
+
+            return queen_moveable(piece_loc, bitboards[B_ALL], bitboards[WB_ALL]) & masks_black(piece_loc);
+
+            break;
+
+        case W_QUEEN:
+
+            return queen_moveable(piece_loc, bitboards[W_ALL], bitboards[WB_ALL]) & masks_white(piece_loc);
+
+            break;
+
+        default:
+            break;
+
+    }
+
+    return 0;
+}
+
+/* Squares a piece other than the king may move to, as far as checks and pins allow */
+SIDE_SPECIALISED uint64_t masks_side(uint8_t side, uint64_t piece) {
+
+    const check_info* info = get_check_info(side);
+
+    // In double check only the king can move
+    if (info->checkers & (info->checkers - 1)) return 0;
+
+    return info->check_mask & pin_mask(info, piece) & ~bitboards[(side == PLAYER_WHITE) ? B_KING : W_KING];
+}
+
+uint64_t masks_white(uint64_t piece) {
+    return masks_side(PLAYER_WHITE, piece);
+}
+
+uint64_t masks_black(uint64_t piece) {
+    return masks_side(PLAYER_BLACK, piece);
+}
+
+/* Determines if a check is a double check from the capture mask */
+uint8_t is_double_checked(uint64_t capture_mask) {
+
+    // WARNING: Bit hack detects if number is a power of 2 but incorrectly
+    // recognises 0, so use AFTER ensuring there is a check.
+    return (capture_mask & (capture_mask - 1)) != 0;
+}
+
+
+/* Convert a square-relative display coordinate into a rank-file index */
+uint8_t dp_to_rf(uint8_t x, uint8_t y) {
+    y = BOARD_SIZE - y - 1;
+    return x + y * BOARD_SIZE;
+}
+
+/* Convert a rank-file index into a square-relative display coordinate */
+void rf_to_dp(uint8_t rf, uint8_t* x, uint8_t* y) {
+    *y = BOARD_SIZE - 1 - rf / BOARD_SIZE;
+    *x = rf % BOARD_SIZE;
+}
+
+
+/* Union of a per-square flash table over every square set in loc */
+static uint64_t table_union(const uint64_t* table, uint64_t loc) {
+    uint64_t att = 0;
+    for_each_bit(sq, loc) {
+        att |= pgm_read_bitboard(&table[sq]);
+    }
+    return att;
+}
+
+/* Set of squares attacked by a king */
+uint64_t king_attacked(uint64_t king_loc) {
+    return table_union(king_table, king_loc);
+}
+
+/* Compute the bitboard of valid moves for a king */
+uint64_t compute_king_incomplete(uint64_t king_loc, uint64_t own_side) {
+    return king_attacked(king_loc) & ~own_side;
+}
+
+/* Set of squares attacked by a knight */
+uint64_t knight_attacked(uint64_t knight_loc) {
+    return table_union(knight_table, knight_loc);
+}
+
+/* Set of squares attacked by a white pawn */
+uint64_t white_pawn_attacked(uint64_t pawn_loc) {
+    return table_union(pawn_table[PLAYER_WHITE], pawn_loc);
+}
+
+/* Set of squares attacked by a black pawn */
+uint64_t black_pawn_attacked(uint64_t pawn_loc) {
+    return table_union(pawn_table[PLAYER_BLACK], pawn_loc);
+}
+
+/* Set of squares attacked by a king, from shifted copies (reference for the tables) */
+uint64_t king_attacked_shift(uint64_t king_loc) {
+
+    // Either side on the king's rank, and the three squares above and below
+    uint64_t beside = east(king_loc) | west(king_loc);
+    uint64_t row = king_loc | beside;
+
+    return beside | north(row) | south(row);
+}
+
+/* Set of squares attacked by a knight, from shifted copies (reference for the tables) */
+uint64_t knight_attacked_shift(uint64_t knight_loc) {
+
+    // One file across then two ranks, or two files across then one rank
+    uint64_t one = east(knight_loc) | west(knight_loc);
+    uint64_t two = east(east(knight_loc)) | west(west(knight_loc));
+
+    return north(north(one)) | south(south(one)) | north(two) | south(two);
+}
+
+/* Set of squares a knight can move to */
+uint64_t knight_moveable(uint64_t knight_loc, uint64_t own_side) {
+    return knight_attacked(knight_loc) & ~own_side;
+}
+
+/* Set of squares attacked by a white pawn, from shifted copies (reference for the tables) */
+uint64_t white_pawn_attacked_shift(uint64_t pawn_loc) {
+
+    // Left and right attacks
+    return north(west(pawn_loc) | east(pawn_loc));
+}
+
+/* Set of squares attacked by a black pawn, from shifted copies (reference for the tables) */
+uint64_t black_pawn_attacked_shift(uint64_t pawn_loc) {
+
+    return south(west(pawn_loc) | east(pawn_loc));
+}
+
+
+/* Set of squares a white pawn can move to */
+uint64_t white_pawn_moveable(uint64_t pawn_loc) {
+
+    // Calculate pawn moves
+
+    // Single space in front of pawn
+    uint64_t one_step = north(pawn_loc) & ~bitboards[WB_ALL];
+
+    // Check second step if one step is possible from rank 2
+    uint64_t two_step = north(one_step & mask_rank[RANK_3]) & ~bitboards[WB_ALL];
+
+    uint64_t valid_moves = one_step | two_step;
+    uint64_t valid_att = white_pawn_attacked(pawn_loc) & bitboards[B_ALL];
+
+    // Compute en passant attacks
+    uint64_t ep_att = (ep_square != NO_SQUARE) ? white_pawn_attacked(pawn_loc) & piece[ep_square] & mask_rank[RANK_6] : 0;
+
+    return valid_moves | valid_att | ep_att;
+}
+
+
+/* Set of squares a black pawn can move to */
+uint64_t black_pawn_moveable(uint64_t pawn_loc) {
+
+    // Calculate pawn moves
+
+    // Single space in front of pawn
+    uint64_t one_step = south(pawn_loc) & ~bitboards[WB_ALL];
+
+    // Check second step if one step is possible from rank 7
+    uint64_t two_step = south(one_step & mask_rank[RANK_6]) & ~bitboards[WB_ALL];
+
+    uint64_t valid_moves = one_step | two_step;
+    uint64_t valid_att = black_pawn_attacked(pawn_loc) & bitboards[W_ALL];
+
+    // Compute en passant attacks
+    uint64_t ep_att = (ep_square != NO_SQUARE) ? black_pawn_attacked(pawn_loc) & piece[ep_square] & mask_rank[RANK_3] : 0;
+
+    return valid_moves | valid_att | ep_att;
+
+}
+
+/* Set of squares a rook can move to */
+uint64_t rook_moveable(uint64_t rook_loc, uint64_t own_side, uint64_t all_pieces) {
+    return rook_attacked(rook_loc, all_pieces) & ~own_side;
+}
+
+/* Set of squares a bishop can move to */
+uint64_t bishop_moveable(uint64_t bishop_loc, uint64_t own_side, uint64_t all_pieces) {
+    return bishop_attacked(bishop_loc, all_pieces) & ~own_side;
+}
+
+/* Set of squares a queen can move to */
+uint64_t queen_moveable(uint64_t queen_loc, uint64_t own_side, uint64_t all_pieces) {
+    return queen_attacked(queen_loc, all_pieces) & ~own_side;
+}
+
+/* Refreshes the parts of one side's attack map that a change can have touched */
+static void update_side_attacks(uint8_t side, uint64_t squares, uint16_t types) {
+
+    uint8_t white = (side == PLAYER_WHITE);
+    uint8_t t = white ? 0 : B_PAWN - W_PAWN;
+    attack_map* a = &attacks[side];
+
+    // Sliders see through the enemy king
+    uint64_t occupied = bitboards[WB_ALL] & ~bitboards[white ? B_KING : W_KING];
+    uint64_t diagonal = bitboards[t + W_BISHOP] | bitboards[t + W_QUEEN];
+    uint64_t straight = bitboards[t + W_ROOK] | bitboards[t + W_QUEEN];
+
+    // Leapers only change when one of their own kind moves
+    if (types & TYPE_BIT(t + W_PAWN)) {
+        // All the pawns at once
+        a->pawns = white ? white_pawn_attacked_shift(bitboards[W_PAWN]) : black_pawn_attacked_shift(bitboards[B_PAWN]);
+    }
+    if (types & TYPE_BIT(t + W_KNIGHT)) {
+        a->knights = knight_attacked(bitboards[t + W_KNIGHT]);
+    }
+    if (types & TYPE_BIT(t + W_KING)) {
+        a->king = king_attacked(bitboards[t + W_KING]);
+    }
+
+    // Sliders also change when a ray of theirs reaches a changed square
+    if ((types & (TYPE_BIT(t + W_BISHOP) | TYPE_BIT(t + W_QUEEN))) ||
+        (bishop_attacked(squares, occupied) & diagonal)) {
+        a->diagonal = bishop_attacked(diagonal, occupied);
+    }
+    if ((types & (TYPE_BIT(t + W_ROOK) | TYPE_BIT(t + W_QUEEN))) ||
+        (rook_attacked(squares, occupied) & straight)) {
+        a->straight = rook_attacked(straight, occupied);
+    }
+
+    a->all = a->pawns | a->knights | a->king | a->diagonal | a->straight;
+}
+
+/* Notes that the contents of some squares (and the bitboards of the given
+ * piece types) have changed. The maps catch up on the next get_attacks, so a
+ * move and its take-back cost one refresh between them.
+ */
+void update_attacks(uint64_t squares, uint16_t types) {
+    pending_squares |= squares;
+    pending_types |= types;
+}
+
+/* Builds both attack maps from scratch on the next read */
+void init_attacks() {
+    update_attacks(0, 0xFFFF);
+}
+
+/* Attack map of one side in the current position */
+const attack_map* get_attacks(uint8_t side) {
+    if (pending_types | pending_squares) {
+        update_side_attacks(PLAYER_WHITE, pending_squares, pending_types);
+        update_side_attacks(PLAYER_BLACK, pending_squares, pending_types);
+        pending_squares = 0;
+        pending_types = 0;
+    }
+    return &attacks[side];
+}
+
+/* Squares a side attacks, seeing through the enemy king */
+SIDE_SPECIALISED uint64_t attacked_minus_king(uint8_t side) {
+    return get_attacks(side)->all;
+}
+
+uint64_t compute_white_attacked_minus_black_king() {
+    return attacked_minus_king(PLAYER_WHITE);
+}
+
+uint64_t compute_black_attacked_minus_white_king() {
+    return attacked_minus_king(PLAYER_BLACK);
+}
+
+/* Squares strictly between two squares on a common line (0 if not aligned) */
+static uint64_t between(uint64_t a, uint64_t b) {
+    uint64_t ends = a | b;
+    if (rook_attacked(a, 0) & b) {
+        return rook_attacked(a, ends) & rook_attacked(b, ends);
+    }
+    if (bishop_attacked(a, 0) & b) {
+        return bishop_attacked(a, ends) & bishop_attacked(b, ends);
+    }
+    return 0;
+}
+
+/* Enemy pieces giving check to a king (capture_mask), and the squares between
+ * it and the sliders among them (push_mask) */
+SIDE_SPECIALISED void is_checked(uint8_t side, uint64_t king_loc, uint64_t* capture_mask, uint64_t* push_mask) {
+
+    // Enemy piece type offset (add to the W_* constants)
+    uint8_t e = (side == PLAYER_WHITE) ? B_PAWN - W_PAWN : 0;
+    uint64_t occupied = bitboards[WB_ALL];
+
+    // Strategy: place enemy piece types on king position and see if they attack a real enemy piece.
+    // Pawns are a unique case as pawn attack direction is tightly coupled.
+    uint64_t pawn_move = (side == PLAYER_WHITE) ? white_pawn_attacked(king_loc) : black_pawn_attacked(king_loc);
+
+    uint64_t sliders = (bishop_attacked(king_loc, occupied) & (bitboards[e + W_BISHOP] | bitboards[e + W_QUEEN])) |
+                       (rook_attacked(king_loc, occupied) & (bitboards[e + W_ROOK] | bitboards[e + W_QUEEN]));
+
+    *capture_mask = (pawn_move & bitboards[e + W_PAWN]) |
+                    (knight_attacked(king_loc) & bitboards[e + W_KNIGHT]) |
+                    sliders;
+
+    // A check is blocked on the line between the king and the slider giving it
+    *push_mask = 0;
+    for_each_bit(sq, sliders) {
+        *push_mask |= between(king_loc, piece[sq]);
+    }
+}
+
+void is_white_checked(uint64_t king_loc, uint64_t* capture_mask, uint64_t* push_mask) {
+    is_checked(PLAYER_WHITE, king_loc, capture_mask, push_mask);
+}
+
+void is_black_checked(uint64_t king_loc, uint64_t* capture_mask, uint64_t* push_mask) {
+    is_checked(PLAYER_BLACK, king_loc, capture_mask, push_mask);
+}
+
+/* Position hashing */
+
+/* Zobrist key of a piece of the given type on a square */
+static uint64_t piece_key(uint8_t type, uint8_t sq) {
+    return pgm_read_bitboard(&zobrist_pieces[type - W_PAWN][sq]);
+}
+
+/* Changes the castling rights, keeping the hash in step */
+static void set_castle_flags(uint8_t flags) {
+    hash_key ^= pgm_read_bitboard(&zobrist_castle[castle_flags]) ^ pgm_read_bitboard(&zobrist_castle[flags]);
+    castle_flags = flags;
+}
+
+/* Changes the en passant square, keeping the hash in step */
+static void set_ep_square(uint8_t sq) {
+    if (ep_square != NO_SQUARE) hash_key ^= pgm_read_bitboard(&zobrist_ep_file[ep_square % BOARD_SIZE]);
+    ep_square = sq;
+    if (ep_square != NO_SQUARE) hash_key ^= pgm_read_bitboard(&zobrist_ep_file[ep_square % BOARD_SIZE]);
+}
+
+/* Zobrist key of the current position worked out from scratch */
+uint64_t compute_hash_key() {
+
+    uint64_t key = 0;
+
+    for (uint8_t type = W_PAWN; type <= B_KING; type++) {
+        uint64_t pieces = bitboards[type];
+        while (pieces) {
+            key ^= piece_key(type, pop_lsb(&pieces));
+        }
+    }
+
+    key ^= pgm_read_bitboard(&zobrist_castle[castle_flags]);
+    if (ep_square != NO_SQUARE) key ^= pgm_read_bitboard(&zobrist_ep_file[ep_square % BOARD_SIZE]);
+    if (current_player == PLAYER_BLACK) key ^= pgm_read_bitboard(&zobrist_side);
+
+    return key;
+}
+
+/* Pawn key of the current position worked out from scratch */
+uint64_t compute_pawn_key() {
+
+    uint64_t key = 0;
+
+    for (uint8_t type = W_PAWN; type <= B_PAWN; type += B_PAWN - W_PAWN) {
+        uint64_t pawns = bitboards[type];
+        while (pawns) {
+            key ^= piece_key(type, pop_lsb(&pawns));
+        }
+    }
+
+    return key;
+}
+
+/* Material and piece-square score */
+
+/* Material and square values of a piece (negative for black) and the phase it is worth */
+static uint8_t piece_score(uint8_t type, uint8_t sq, int16_t* mg, int16_t* eg) {
+
+    uint8_t white = (type < B_PAWN);
+    uint8_t i = type - (white ? W_PAWN : B_PAWN);
+
+    // Black reads the tables with the rank mirrored
+    if (!white) sq ^= (BOARD_SIZE - 1) * BOARD_SIZE;
+
+    *mg = (int16_t) pgm_read_word(&pst_mg[i][sq]);
+    *eg = (int16_t) pgm_read_word(&pst_eg[i][sq]);
+
+    if (!white) {
+        *mg = -*mg;
+        *eg = -*eg;
+    }
+
+    return pgm_read_byte(&phase_weight[i]);
+}
+
+/* Adds a piece's material and square values to the score, or takes them away */
+static void score_piece(uint8_t type, uint8_t sq, uint8_t add) {
+
+    int16_t mg, eg;
+    uint8_t phase = piece_score(type, sq, &mg, &eg);
+
+    if (add) {
+        score_mg += mg;
+        score_eg += eg;
+        score_phase += phase;
+    } else {
+        score_mg -= mg;
+        score_eg -= eg;
+        score_phase -= phase;
+    }
+}
+
+/* Material and piece-square score of the current position worked out from scratch */
+void compute_score(int16_t* mg, int16_t* eg, uint8_t* phase) {
+
+    int16_t piece_mg, piece_eg;
+
+    *mg = *eg = 0;
+    *phase = 0;
+
+    for (uint8_t type = W_PAWN; type <= B_KING; type++) {
+        uint64_t pieces = bitboards[type];
+        while (pieces) {
+            *phase += piece_score(type, pop_lsb(&pieces), &piece_mg, &piece_eg);
+            *mg += piece_mg;
+            *eg += piece_eg;
+        }
+    }
+}
+
+/* Hands the squares a piece movement function changed on to the attack maps,
+ * the check cache and the display.
+ */
+static void squares_changed(uint64_t squares, uint16_t types) {
+    update_attacks(squares, types);
+    reset_check_info();
+    changed_squares |= squares;
+}
+
+/* Squares whose contents changed since the last call, for the display to repaint */
+uint64_t take_changed_squares() {
+    uint64_t squares = changed_squares;
+    changed_squares = 0;
+    return squares;
+}
+
+void move_piece(uint64_t p, uint64_t q, uint8_t px, uint8_t py, uint8_t qx, uint8_t qy, uint8_t own_side, uint8_t enemy_side) {
+
+    // Moving piece type
+    uint8_t t = board[px][py];
+
+    // Destination piece type
+    uint8_t u = board[qx][qy];
+
+    // Update castling rights: moving from or onto a king or rook home square loses them
+    uint64_t touched = p | q;
+    uint8_t flags = castle_flags;
+    if (touched & (WHITE_KING_INITIAL | WHITE_KINGSIDE_ROOK)) {
+        flags &= ~(1 << CASTLE_WHITE_KINGSIDE);
+    }
+    if (touched & (WHITE_KING_INITIAL | WHITE_QUEENSIDE_ROOK)) {
+        flags &= ~(1 << CASTLE_WHITE_QUEENSIDE);
+    }
+    if (touched & (BLACK_KING_INITIAL | BLACK_KINGSIDE_ROOK)) {
+        flags &= ~(1 << CASTLE_BLACK_KINGSIDE);
+    }
+    if (touched & (BLACK_KING_INITIAL | BLACK_QUEENSIDE_ROOK)) {
+        flags &= ~(1 << CASTLE_BLACK_QUEENSIDE);
+    }
+    set_castle_flags(flags);
+
+    // Update hash
+    uint8_t from = lsb(p);
+    uint8_t to = lsb(q);
+    hash_key ^= piece_key(t, from) ^ piece_key(t, to);
+    if (u != EMPTY) hash_key ^= piece_key(u, to);
+    if (t == W_PAWN || t == B_PAWN) pawn_key ^= piece_key(t, from) ^ piece_key(t, to);
+    if (u == W_PAWN || u == B_PAWN) pawn_key ^= piece_key(u, to);
+
+    // Update score
+    score_piece(t, from, 0);
+    score_piece(t, to, 1);
+    if (u != EMPTY) score_piece(u, to, 0);
+
+    // Unset current position of moving piece
+    bitboards[t] &= ~p;
+    // Set new position of moving piece
+    bitboards[t] |= q;
+
+    // Remove taken piece
+    bitboards[u] &= ~q;
+    bitboards[enemy_side] &= ~q;
+
+    // Update own side bitboard
+    bitboards[own_side] &= ~p;
+    bitboards[own_side] |= q;
+
+    // Update all piece bitboard
+    bitboards[WB_ALL] = bitboards[own_side] | bitboards[enemy_side];
+
+    // Update lookup table
+    board[px][py] = EMPTY;
+    board[qx][qy] = t;
+
+    squares_changed(p | q, TYPE_BIT(t) | TYPE_BIT(u));
+
+}
+
+/* Takes whatever piece stands on a square off the board */
+void remove_piece(uint64_t piece_loc, uint8_t x, uint8_t y) {
+    uint8_t t = board[x][y];
+    bitboards[t] &= ~piece_loc;
+    bitboards[B_ALL] &= ~piece_loc;
+    bitboards[W_ALL] &= ~piece_loc;
+    bitboards[WB_ALL] &= ~piece_loc;
+    board[x][y] = EMPTY;
+    hash_key ^= piece_key(t, lsb(piece_loc));
+    if (t == W_PAWN || t == B_PAWN) pawn_key ^= piece_key(t, lsb(piece_loc));
+    score_piece(t, lsb(piece_loc), 0);
+    squares_changed(piece_loc, TYPE_BIT(t));
+}
+
+/* Puts a piece of the given type on an empty square */
+void put_piece(uint64_t piece_loc, uint8_t x, uint8_t y, uint8_t type) {
+    bitboards[type] |= piece_loc;
+    bitboards[(type < B_PAWN) ? W_ALL : B_ALL] |= piece_loc;
+    bitboards[WB_ALL] |= piece_loc;
+    board[x][y] = type;
+    hash_key ^= piece_key(type, lsb(piece_loc));
+    if (type == W_PAWN || type == B_PAWN) pawn_key ^= piece_key(type, lsb(piece_loc));
+    score_piece(type, lsb(piece_loc), 1);
+    squares_changed(piece_loc, TYPE_BIT(type));
+}
+
+/* Rooks a side may castle with: the right is kept, the king's path is not
+ * attacked and nothing stands between king and rook */
+SIDE_SPECIALISED uint64_t castle_set_side(uint8_t side) {
+
+    uint64_t castle_set = 0;
+
+    // Back rank squares and castling rights of the side (black's follow white's)
+    uint8_t home = (side == PLAYER_WHITE) ? 0 : (BOARD_SIZE - 1) * BOARD_SIZE;
+    uint8_t rights = castle_flags >> ((side == PLAYER_WHITE) ? 0 : CASTLE_BLACK_KINGSIDE);
+
+    uint64_t attacked = get_attacks(!side)->all;
+
+    uint64_t kingside_attacked = (piece[home + FILE_E] | piece[home + FILE_F] | piece[home + FILE_G]) & attacked;
+    uint64_t queenside_attacked = (piece[home + FILE_E] | piece[home + FILE_D] | piece[home + FILE_C]) & attacked;
+
+    // Ray from king to rook
+    uint64_t hray = rook_attacked(piece[home + FILE_E], bitboards[WB_ALL]);
+
+    if (rights & (1 << CASTLE_WHITE_KINGSIDE) && kingside_attacked == 0 && (hray & piece[home + FILE_H]))
+        castle_set |= piece[home + FILE_H];
+
+    if (rights & (1 << CASTLE_WHITE_QUEENSIDE) && queenside_attacked == 0 && (hray & piece[home + FILE_A]))
+        castle_set |= piece[home + FILE_A];
+
+    return castle_set;
+
+}
+
+uint64_t castle_set_white() {
+    return castle_set_side(PLAYER_WHITE);
+}
+
+uint64_t castle_set_black() {
+    return castle_set_side(PLAYER_BLACK);
+}
+
+void castle(uint64_t castle_square) {
+
+    uint64_t king_initial;
+    uint64_t king_castled;
+    uint64_t rook_initial;
+    uint64_t rook_castled;
+
+    uint8_t side;
+    uint8_t king;
+    uint8_t rook;
+
+    if (castle_square & WHITE_KINGSIDE_ROOK) {
+
+        // Set initialisation variables
+        king_initial = WHITE_KING_INITIAL;
+        king_castled = WHITE_KINGSIDE_KING_CASTLED;
+        rook_initial = WHITE_KINGSIDE_ROOK;
+        rook_castled = WHITE_KINGSIDE_ROOK_CASTLED;
+        side = W_ALL;
+        king = W_KING;
+        rook = W_ROOK;
+
+        // Update flags
+        set_castle_flags(castle_flags & ~((1 << CASTLE_WHITE_KINGSIDE) | (1 << CASTLE_WHITE_QUEENSIDE)));
+
+        // Update display representation
+        board[4][7] = EMPTY;
+        board[7][7] = EMPTY;
+        board[6][7] = W_KING;
+        board[5][7] = W_ROOK;
+
+    } else if (castle_square & WHITE_QUEENSIDE_ROOK) {
+
+        king_initial = WHITE_KING_INITIAL;
+        king_castled = WHITE_QUEENSIDE_KING_CASTLED;
+        rook_initial = WHITE_QUEENSIDE_ROOK;
+        rook_castled = WHITE_QUEENSIDE_ROOK_CASTLED;
+        side = W_ALL;
+        king = W_KING;
+        rook = W_ROOK;
+
+        set_castle_flags(castle_flags & ~((1 << CASTLE_WHITE_KINGSIDE) | (1 << CASTLE_WHITE_QUEENSIDE)));
+
+        board[4][7] = EMPTY;
+        board[0][7] = EMPTY;
+        board[2][7] = W_KING;
+        board[3][7] = W_ROOK;
+
+    } else if (castle_square & BLACK_KINGSIDE_ROOK) {
+
+        king_initial = BLACK_KING_INITIAL;
+        king_castled = BLACK_KINGSIDE_KING_CASTLED;
+        rook_initial = BLACK_KINGSIDE_ROOK;
+        rook_castled = BLACK_KINGSIDE_ROOK_CASTLED;
+        side = B_ALL;
+        king = B_KING;
+        rook = B_ROOK;
+
+        set_castle_flags(castle_flags & ~((1 << CASTLE_BLACK_KINGSIDE) | (1 << CASTLE_BLACK_QUEENSIDE)));
+
+        board[4][0] = EMPTY;
+        board[7][0] = EMPTY;
+        board[6][0] = B_KING;
+        board[5][0] = B_ROOK;
+
+    } else if (castle_square & BLACK_QUEENSIDE_ROOK) {
+
+        king_initial = BLACK_KING_INITIAL;
+        king_castled = BLACK_QUEENSIDE_KING_CASTLED;
+        rook_initial = BLACK_QUEENSIDE_ROOK;
+        rook_castled = BLACK_QUEENSIDE_ROOK_CASTLED;
+        side = B_ALL;
+        king = B_KING;
+        rook = B_ROOK;
+
+        set_castle_flags(castle_flags & ~((1 << CASTLE_BLACK_KINGSIDE) | (1 << CASTLE_BLACK_QUEENSIDE)));
+
+        board[4][0] = EMPTY;
+        board[0][0] = EMPTY;
+        board[2][0] = B_KING;
+        board[3][0] = B_ROOK;
+
+    }
+    else {
+        // SHOULDN'T HAPPEN
+        return;
+    }
+
+    // Move king
+    bitboards[king] = king_castled;
+    
+    // Move rook
+    bitboards[rook] &= ~rook_initial;
+    bitboards[rook] |= rook_castled;
+
+    // Update side board
+    bitboards[side] &= ~king_initial & ~rook_initial;
+    bitboards[side] |= king_castled | rook_castled;
+
+    // Update global board
+    bitboards[WB_ALL] = bitboards[W_ALL] | bitboards[B_ALL];
+
+    // Update hash
+    hash_key ^= piece_key(king, lsb(king_initial)) ^ piece_key(king, lsb(king_castled));
+    hash_key ^= piece_key(rook, lsb(rook_initial)) ^ piece_key(rook, lsb(rook_castled));
+
+    // Update score
+    score_piece(king, lsb(king_initial), 0);
+    score_piece(king, lsb(king_castled), 1);
+    score_piece(rook, lsb(rook_initial), 0);
+    score_piece(rook, lsb(rook_castled), 1);
+
+    squares_changed(king_initial | king_castled | rook_initial | rook_castled, TYPE_BIT(king) | TYPE_BIT(rook));
+
+}
+
+/* Line a piece is pinned along, including the pinner (all squares if not pinned) */
+SIDE_SPECIALISED uint64_t compute_pin_mask_side(uint8_t side, uint64_t piece) {
+    return pin_mask(get_check_info(side), piece);
+}
+
+uint64_t compute_pin_mask_white(uint64_t piece) {
+    return compute_pin_mask_side(PLAYER_WHITE, piece);
+}
+
+uint64_t compute_pin_mask_black(uint64_t piece) {
+    return compute_pin_mask_side(PLAYER_BLACK, piece);
+}
+
+/* Legal move generation */
+
+/* Check and pin cache */
+
+// One entry per side, each filled on first use after the position changes
+static check_info check_cache[2];
+static uint8_t check_cache_valid = 0;
+
+/* Forgets the cached check and pin state. Everything that moves pieces calls this. */
+void reset_check_info() {
+    check_cache_valid = 0;
+}
+
+/* Works out checkers, the check mask and pins for one side's king */
+static void compute_check_info(uint8_t side, check_info* info) {
+
+    uint8_t white = (side == PLAYER_WHITE);
+    uint8_t t = white ? 0 : B_PAWN - W_PAWN;
+    uint8_t e = white ? B_PAWN - W_PAWN : 0;
+
+    uint64_t own = bitboards[white ? W_ALL : B_ALL];
+    uint64_t enemy = bitboards[white ? B_ALL : W_ALL];
+    uint64_t occupied = bitboards[WB_ALL];
+    uint64_t king = bitboards[t + W_KING];
+
+    uint64_t enemy_diagonal = bitboards[e + W_BISHOP] | bitboards[e + W_QUEEN];
+    uint64_t enemy_straight = bitboards[e + W_ROOK] | bitboards[e + W_QUEEN];
+
+    // Enemy pieces giving check, found by looking outwards from the king if it is attacked at all
+    info->checkers = 0;
+    if (king & get_attacks(!side)->all) {
+        uint64_t pawn_att = white ? white_pawn_attacked(king) : black_pawn_attacked(king);
+        info->checkers = (pawn_att & bitboards[e + W_PAWN]) |
+                         (knight_attacked(king) & bitboards[e + W_KNIGHT]) |
+                         (bishop_attacked(king, occupied) & enemy_diagonal) |
+                         (rook_attacked(king, occupied) & enemy_straight);
+    }
+
+    // Other pieces must capture a single checker or block its ray
+    info->check_mask = 0xFFFFFFFFFFFFFFFF;
+    if (info->checkers && !(info->checkers & (info->checkers - 1))) {
+        info->check_mask = info->checkers | between(king, info->checkers);
+    }
+
+    // Pins: a lone own piece between the king and an enemy slider may only move along that line
+    info->pinned = 0;
+    info->pins = 0;
+
+    uint64_t snipers = (bishop_attacked(king, enemy) & enemy_diagonal) |
+                       (rook_attacked(king, enemy) & enemy_straight);
+    while (snipers) {
+        uint64_t sniper = piece[pop_lsb(&snipers)];
+
+        uint64_t ray = between(king, sniper);
+        uint64_t blockers = ray & occupied;
+        if ((blockers & own) && !(blockers & (blockers - 1))) {
+            info->pinned |= blockers;
+            info->pin_square[info->pins] = lsb(blockers);
+            info->pin_ray[info->pins++] = ray | sniper;
+        }
+    }
+}
+
+/* Check and pin state of a side in the current position */
+const check_info* get_check_info(uint8_t side) {
+    if (!(check_cache_valid & (1 << side))) {
+        compute_check_info(side, &check_cache[side]);
+        check_cache_valid |= 1 << side;
+    }
+    return &check_cache[side];
+}
+
+/* Squares pieces may stay on given their pins: all squares if any of them is
+ * free, otherwise the union of their pin rays.
+ */
+uint64_t pin_mask(const check_info* info, uint64_t pieces) {
+
+    if (pieces & ~info->pinned) return 0xFFFFFFFFFFFFFFFF;
+
+    uint64_t mask = 0;
+    for (uint8_t i = 0; i < info->pins; i++) {
+        if (pieces & piece[info->pin_square[i]]) mask |= info->pin_ray[i];
+    }
+    return mask;
+}
+
+/* Appends a move from one square to each target, flagging captures */
+static void add_moves(move_list* list, uint8_t from, uint64_t targets, uint64_t enemy) {
+    while (targets) {
+        uint8_t to = pop_lsb(&targets);
+        list->moves[list->count++] = MOVE(from, to, (enemy & piece[to]) ? MOVE_CAPTURE : MOVE_QUIET);
+    }
+}
+
+/* As add_moves, but expands moves onto the last rank into the four promotions */
+static void add_pawn_moves(move_list* list, uint8_t from, uint64_t targets, uint64_t enemy) {
+    while (targets) {
+        uint8_t to = pop_lsb(&targets);
+
+        uint8_t flag = (enemy & piece[to]) ? MOVE_CAPTURE : MOVE_QUIET;
+
+        if (piece[to] & (mask_rank[RANK_1] | mask_rank[RANK_8])) {
+            for (uint8_t promote = PROMOTE_KNIGHT; promote <= PROMOTE_QUEEN; promote++) {
+                list->moves[list->count++] = MOVE(from, to, flag | MOVE_PROMOTION | promote);
+            }
+        } else if (to == from + 2 * BOARD_SIZE || from == to + 2 * BOARD_SIZE) {
+            list->moves[list->count++] = MOVE(from, to, MOVE_DOUBLE_PUSH);
+        } else {
+            list->moves[list->count++] = MOVE(from, to, flag);
+        }
+    }
+}
+
+/* Fills the list with the legal moves of the given kinds (GEN_*) that the side
+ * to move can make with the pieces on the given squares, and returns how many
+ * there are. Checkers and pins come from the per-position cache, so each piece's
+ * targets are just its attacks masked by them.
+ */
+uint8_t generate_kinds(move_list* list, uint8_t kinds, uint64_t pieces) {
+
+    uint8_t white = (current_player == PLAYER_WHITE);
+
+    // Piece type offsets of each side (add to the W_* constants)
+    uint8_t t = white ? 0 : B_PAWN - W_PAWN;
+    uint8_t e = white ? B_PAWN - W_PAWN : 0;
+
+    uint64_t own = bitboards[white ? W_ALL : B_ALL];
+    uint64_t enemy = bitboards[white ? B_ALL : W_ALL];
+    uint64_t occupied = bitboards[WB_ALL];
+
+    uint64_t king = bitboards[t + W_KING];
+    uint8_t king_sq = lsb(king);
+
+    uint64_t enemy_diagonal = bitboards[e + W_BISHOP] | bitboards[e + W_QUEEN];
+    uint64_t enemy_straight = bitboards[e + W_ROOK] | bitboards[e + W_QUEEN];
+
+    const check_info* info = get_check_info(current_player);
+    uint64_t checkers = info->checkers;
+    uint64_t check_mask = info->check_mask;
+    uint64_t pinned = info->pinned;
+
+    // Targets each kind of move may land on. Pawn pushes onto the last rank
+    // promote, so they count as captures.
+    uint64_t last_ranks = mask_rank[RANK_1] | mask_rank[RANK_8];
+    uint64_t keep = ((kinds & GEN_CAPTURES) ? enemy : 0) | ((kinds & GEN_QUIETS) ? ~enemy : 0);
+    uint64_t pawn_keep = ((kinds & GEN_CAPTURES) ? enemy | last_ranks : 0) |
+                         ((kinds & GEN_QUIETS) ? ~enemy & ~last_ranks : 0);
+
+    list->count = 0;
+
+    // King moves. The king is lifted off the board so it cannot hide in its own shadow.
+    uint64_t danger = get_attacks(!current_player)->all;
+    if (king & pieces) add_moves(list, king_sq, king_attacked(king) & ~own & ~danger & keep, enemy);
+
+    // In double check only the king can move
+    if (checkers & (checkers - 1)) return list->count;
+
+    // Pawns, knights, bishops, rooks and queens
+    uint64_t empty = ~occupied;
+    for (uint8_t type = W_PAWN; type <= W_QUEEN; type++) {
+
+        uint64_t movers = bitboards[t + type] & pieces;
+        while (movers) {
+            uint8_t from = pop_lsb(&movers);
+            uint64_t p = piece[from];
+
+            uint64_t targets;
+            switch (type) {
+                case W_PAWN:
+                    if (white) {
+                        uint64_t one_step = north(p) & empty;
+                        targets = one_step | (north(one_step & mask_rank[RANK_3]) & empty) |
+                                  (white_pawn_attacked(p) & enemy);
+                    } else {
+                        uint64_t one_step = south(p) & empty;
+                        targets = one_step | (south(one_step & mask_rank[RANK_6]) & empty) |
+                                  (black_pawn_attacked(p) & enemy);
+                    }
+                    break;
+                case W_KNIGHT:
+                    targets = knight_attacked(p);
+                    break;
+                case W_BISHOP:
+                    targets = bishop_attacked(p, occupied);
+                    break;
+                case W_ROOK:
+                    targets = rook_attacked(p, occupied);
+                    break;
+                default:
+                    targets = queen_attacked(p, occupied);
+                    break;
+            }
+
+            targets &= ~own & check_mask & ((type == W_PAWN) ? pawn_keep : keep);
+
+            if (p & pinned) targets &= pin_mask(info, p);
+
+            if (type == W_PAWN) {
+                add_pawn_moves(list, from, targets, enemy);
+            } else {
+                add_moves(list, from, targets, enemy);
+            }
+        }
+    }
+
+    // En passant. Lifting both pawns at once can uncover a slider on the king
+    // (even along the rank), so the test is redone on the resulting occupancy.
+    if (ep_square != NO_SQUARE && (kinds & GEN_CAPTURES)) {
+        uint64_t to = piece[ep_square];
+        uint64_t captured = white ? south(to) : north(to);
+        uint64_t capturers = (white ? black_pawn_attacked(to) : white_pawn_attacked(to)) & bitboards[t + W_PAWN] & pieces;
+
+        if (!((to | captured) & check_mask)) capturers = 0;
+
+        while (capturers) {
+            uint8_t from = pop_lsb(&capturers);
+
+            uint64_t after = (occupied & ~piece[from] & ~captured) | to;
+            if ( !(bishop_attacked(king, after) & enemy_diagonal) &&
+                 !(rook_attacked(king, after) & enemy_straight) ) {
+                list->moves[list->count++] = MOVE(from, ep_square, MOVE_EN_PASSANT);
+            }
+        }
+    }
+
+    // Castling, when not in check, through empty squares the king does not see attacked
+    uint8_t home = white ? 0 : BOARD_SIZE * RANK_8;
+    if ((kinds & GEN_QUIETS) && (king & pieces) && !checkers && king == piece[home + FILE_E]) {
+
+        uint64_t rooks = bitboards[t + W_ROOK];
+        uint8_t kingside = white ? CASTLE_WHITE_KINGSIDE : CASTLE_BLACK_KINGSIDE;
+        uint8_t queenside = white ? CASTLE_WHITE_QUEENSIDE : CASTLE_BLACK_QUEENSIDE;
+
+        uint64_t kingside_path = piece[home + FILE_F] | piece[home + FILE_G];
+        uint64_t queenside_path = piece[home + FILE_D] | piece[home + FILE_C];
+
+        if ( (castle_flags & (1 << kingside)) && (rooks & piece[home + FILE_H]) &&
+             !((occupied | danger) & kingside_path) ) {
+            list->moves[list->count++] = MOVE(home + FILE_E, home + FILE_G, MOVE_CASTLE_KINGSIDE);
+        }
+
+        if ( (castle_flags & (1 << queenside)) && (rooks & piece[home + FILE_A]) &&
+             !(occupied & (queenside_path | piece[home + FILE_B])) && !(danger & queenside_path) ) {
+            list->moves[list->count++] = MOVE(home + FILE_E, home + FILE_C, MOVE_CASTLE_QUEENSIDE);
+        }
+    }
+
+    return list->count;
+}
+
+/* Fills the list with every legal move of the side to move and returns how many there are */
+uint8_t generate_legal(move_list* list) {
+    return generate_kinds(list, GEN_ALL, ~(uint64_t) 0);
+}
+
+/* Whether the side to move has any legal move, to tell mate and stalemate from
+ * play going on. The cheapest candidates go first and the first legal move
+ * ends the search: king steps, then taking a lone checker, then the unpinned
+ * pieces a kind at a time (set-wise), pinned pieces, and en passant last.
+ * Castling is never needed: a king that may castle may also step aside.
+ */
+uint8_t side_has_legal_move() {
+
+    uint8_t white = (current_player == PLAYER_WHITE);
+    uint8_t t = white ? 0 : B_PAWN - W_PAWN;
+    uint8_t e = white ? B_PAWN - W_PAWN : 0;
+
+    uint64_t own = bitboards[white ? W_ALL : B_ALL];
+    uint64_t enemy = bitboards[white ? B_ALL : W_ALL];
+    uint64_t occupied = bitboards[WB_ALL];
+    uint64_t empty = ~occupied;
+    uint64_t king = bitboards[t + W_KING];
+
+    // King steps (the attack maps see through the king, so it cannot hide in its own shadow)
+    if (king_attacked(king) & ~own & ~get_attacks(!current_player)->all) return 1;
+
+    const check_info* info = get_check_info(current_player);
+    uint64_t checkers = info->checkers;
+    uint64_t check_mask = info->check_mask;
+    uint64_t pinned = info->pinned;
+
+    // In double check only the king can move
+    if (checkers & (checkers - 1)) return 0;
+
+    uint64_t pawns = bitboards[t + W_PAWN];
+    uint64_t knights = bitboards[t + W_KNIGHT];
+    uint64_t diagonal = bitboards[t + W_BISHOP] | bitboards[t + W_QUEEN];
+    uint64_t straight = bitboards[t + W_ROOK] | bitboards[t + W_QUEEN];
+
+    // Taking a single checker, with a piece not pinned away from it
+    if (checkers) {
+        uint64_t takers = ((white ? black_pawn_attacked(checkers) : white_pawn_attacked(checkers)) & pawns) |
+                          (knight_attacked(checkers) & knights) |
+                          (bishop_attacked(checkers, occupied) & diagonal) |
+                          (rook_attacked(checkers, occupied) & straight);
+        if (takers & ~pinned) return 1;
+        while (takers) {
+            uint64_t p = piece[pop_lsb(&takers)];
+            if (pin_mask(info, p) & checkers) return 1;
+        }
+    }
+
+    uint64_t targets = ~own & check_mask;
+
+    // Unpinned pieces, every piece of a kind at once
+    uint64_t free = ~pinned;
+    if (knight_attacked(knights & free) & targets) return 1;
+
+    uint64_t one_step = (white ? north(pawns & free) : south(pawns & free)) & empty;
+    uint64_t two_step = (white ? north(one_step & mask_rank[RANK_3]) : south(one_step & mask_rank[RANK_6])) & empty;
+    uint64_t pawn_takes = (white ? white_pawn_attacked_shift(pawns & free) : black_pawn_attacked_shift(pawns & free)) & enemy;
+    if ((one_step | two_step | pawn_takes) & check_mask) return 1;
+
+    if (bishop_attacked(diagonal & free, occupied) & targets) return 1;
+    if (rook_attacked(straight & free, occupied) & targets) return 1;
+
+    // Pinned pieces, along their pin lines (never out of check: a pin line only meets a check line at the king)
+    if (!checkers) {
+        for (uint8_t i = 0; i < info->pins; i++) {
+            uint64_t p = piece[info->pin_square[i]];
+            uint64_t moves;
+            if (p & pawns) {
+                uint64_t step = (white ? north(p) : south(p)) & empty;
+                moves = step | ((white ? north(step & mask_rank[RANK_3]) : south(step & mask_rank[RANK_6])) & empty) |
+                        ((white ? white_pawn_attacked(p) : black_pawn_attacked(p)) & enemy);
+            } else if (p & knights) {
+                moves = 0;
+            } else {
+                moves = ((p & diagonal) ? bishop_attacked(p, occupied) : 0) |
+                        ((p & straight) ? rook_attacked(p, occupied) : 0);
+            }
+            if (moves & ~own & info->pin_ray[i]) return 1;
+        }
+    }
+
+    // En passant, which can uncover a slider on the king even along the rank
+    if (ep_square != NO_SQUARE) {
+        uint64_t to = piece[ep_square];
+        uint64_t captured = white ? south(to) : north(to);
+        uint64_t capturers = (white ? black_pawn_attacked(to) : white_pawn_attacked(to)) & pawns;
+
+        if (!((to | captured) & check_mask)) capturers = 0;
+
+        uint64_t enemy_diagonal = bitboards[e + W_BISHOP] | bitboards[e + W_QUEEN];
+        uint64_t enemy_straight = bitboards[e + W_ROOK] | bitboards[e + W_QUEEN];
+
+        while (capturers) {
+            uint64_t from = piece[pop_lsb(&capturers)];
+
+            uint64_t after = (occupied & ~from & ~captured) | to;
+            if ( !(bishop_attacked(king, after) & enemy_diagonal) &&
+                 !(rook_attacked(king, after) & enemy_straight) ) {
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/* Legal destinations of each piece of the side to move, indexed by rank-file
+ * square, the way the UI picks them: castling is the king onto its rook, and a
+ * promotion is one destination. Returns the number of legal moves.
+ */
+uint8_t legal_destinations(uint64_t* destinations) {
+
+    move_list list;
+    memset(destinations, 0, BOARD_SIZE * BOARD_SIZE * sizeof(uint64_t));
+
+    generate_legal(&list);
+
+    for (uint8_t i = 0; i < list.count; i++) {
+        uint8_t from = MOVE_FROM(list.moves[i]);
+        uint8_t to = MOVE_TO(list.moves[i]);
+        if (MOVE_FLAG(list.moves[i]) == MOVE_CASTLE_KINGSIDE) to = from + 3;
+        if (MOVE_FLAG(list.moves[i]) == MOVE_CASTLE_QUEENSIDE) to = from - 4;
+        destinations[from] |= piece[to];
+    }
+
+    return list.count;
+}
+
+/* Staged move generation */
+
+/* Piece type on a rank-file index */
+static uint8_t type_on(uint8_t sq) {
+    uint8_t x, y;
+    rf_to_dp(sq, &x, &y);
+    return board[x][y];
+}
+
+/* Ordering key of a capture or promotion: queen promotions first, then the most
+ * valuable victim, the least valuable attacker breaking ties. 0 for other moves. */
+uint8_t capture_order(uint16_t move) {
+
+    uint8_t flag = MOVE_FLAG(move);
+
+    if (flag & MOVE_PROMOTION) {
+        return ((flag & PROMOTE_QUEEN) == PROMOTE_QUEEN) ? ORDER_QUEEN_PROMOTION : 1;
+    }
+
+    if (!(flag & MOVE_CAPTURE)) return 0;
+
+    // Fold both colours onto the white types; en passant takes a pawn off an empty square
+    uint8_t victim = type_on(MOVE_TO(move));
+    uint8_t attacker = type_on(MOVE_FROM(move));
+    if (victim == EMPTY) victim = W_PAWN;
+    if (victim > W_KING) victim -= B_PAWN - W_PAWN;
+    if (attacker > W_KING) attacker -= B_PAWN - W_PAWN;
+
+    return ORDER_CAPTURE + BOARD_SIZE * victim - attacker;
+}
+
+/* Whether a move suggested from elsewhere (a killer from a sibling position,
+ * say) is a legal quiet move here. Overwrites the scratch list. */
+uint8_t is_legal_quiet(uint16_t move, move_list* scratch) {
+
+    if (move == NULL_MOVE || (MOVE_FLAG(move) & (MOVE_CAPTURE | MOVE_PROMOTION))) return 0;
+
+    generate_kinds(scratch, GEN_QUIETS, piece[MOVE_FROM(move)]);
+
+    for (uint8_t i = 0; i < scratch->count; i++) {
+        if (scratch->moves[i] == move) return 1;
+    }
+    return 0;
+}
+
+/* Starts handing out the moves of the current position. The hints (up to
+ * MAX_HINTS) are tried after the captures, if legal here. */
+void init_picker(move_picker* picker, const uint16_t* hints, uint8_t count) {
+    picker->phase = PICK_CAPTURES;
+    picker->list.count = 0;
+    picker->next = 0;
+    picker->hints[0] = (count > 0) ? hints[0] : NULL_MOVE;
+    picker->hints[1] = (count > 1 && hints[1] != hints[0]) ? hints[1] : NULL_MOVE;
+}
+
+/* Next move of the current position, or NULL_MOVE when there are no more.
+ * Each phase is generated only when the one before has run dry. */
+uint16_t pick_move(move_picker* picker) {
+
+    move_list* list = &picker->list;
+
+    switch (picker->phase) {
+
+        case PICK_CAPTURES:
+            generate_kinds(list, GEN_CAPTURES, ~(uint64_t) 0);
+            picker->next = 0;
+            picker->phase = PICK_CAPTURES_NEXT;
+            // Fall through
+
+        case PICK_CAPTURES_NEXT:
+            if (picker->next < list->count) {
+                // Bring the best remaining capture forward
+                uint8_t best = picker->next;
+                uint8_t best_order = capture_order(list->moves[best]);
+                for (uint8_t i = best + 1; i < list->count; i++) {
+                    uint8_t order = capture_order(list->moves[i]);
+                    if (order > best_order) {
+                        best = i;
+                        best_order = order;
+                    }
+                }
+                uint16_t move = list->moves[best];
+                list->moves[best] = list->moves[picker->next];
+                list->moves[picker->next++] = move;
+                return move;
+            }
+            picker->next = 0;
+            picker->phase = PICK_HINTS_NEXT;
+            // Fall through
+
+        case PICK_HINTS_NEXT:
+            // The captures are spent, so the list is free to check hints with
+            while (picker->next < MAX_HINTS) {
+                uint16_t move = picker->hints[picker->next++];
+                if (is_legal_quiet(move, list)) return move;
+            }
+            picker->phase = PICK_QUIETS;
+            // Fall through
+
+        case PICK_QUIETS:
+            generate_kinds(list, GEN_QUIETS, ~(uint64_t) 0);
+            picker->next = 0;
+            picker->phase = PICK_QUIETS_NEXT;
+            // Fall through
+
+        case PICK_QUIETS_NEXT:
+            while (picker->next < list->count) {
+                uint16_t move = list->moves[picker->next++];
+                // Hints already handed out are skipped
+                if (move != picker->hints[0] && move != picker->hints[1]) return move;
+            }
+            picker->phase = PICK_DONE;
+            // Fall through
+
+        default:
+            return NULL_MOVE;
+    }
+}
+
+/* Plays a move from generate_legal on the game state, then hands over the turn */
+uint8_t apply_move(uint16_t move) {
+
+    uint8_t from = MOVE_FROM(move);
+    uint8_t to = MOVE_TO(move);
+    uint8_t flag = MOVE_FLAG(move);
+    uint8_t played = PLAYED_NORMAL;
+
+    set_ep_square(NO_SQUARE);
+
+    if (flag == MOVE_CASTLE_KINGSIDE || flag == MOVE_CASTLE_QUEENSIDE) {
+
+        // castle() is keyed by the rook's home square
+        castle(piece[(flag == MOVE_CASTLE_KINGSIDE) ? from + 3 : from - 4]);
+        played = PLAYED_CASTLE;
+
+    } else {
+
+        uint8_t px, py, qx, qy;
+        rf_to_dp(from, &px, &py);
+        rf_to_dp(to, &qx, &qy);
+
+        uint8_t own_side = (current_player == PLAYER_WHITE) ? W_ALL : B_ALL;
+        uint8_t enemy_side = (own_side == W_ALL) ? B_ALL : W_ALL;
+
+        // The pawn taken en passant sits beside the mover, behind the target square
+        if (flag == MOVE_EN_PASSANT) {
+            remove_piece(piece[(current_player == PLAYER_WHITE) ? to - BOARD_SIZE : to + BOARD_SIZE], qx, py);
+            played = PLAYED_EN_PASSANT;
+        }
+
+        move_piece(piece[from], piece[to], px, py, qx, qy, own_side, enemy_side);
+
+        // Swap the pawn for the promoted piece (piece types follow the pawn in order)
+        if (flag & MOVE_PROMOTION) {
+            uint8_t promoted = board[qx][qy] + W_KNIGHT - W_PAWN + (flag & PROMOTE_QUEEN);
+            remove_piece(piece[to], qx, qy);
+            put_piece(piece[to], qx, qy, promoted);
+        }
+
+        // Record the skipped square only if an enemy pawn stands ready to take on it
+        if (flag == MOVE_DOUBLE_PUSH) {
+            uint8_t target = (from + to) / 2;
+            uint64_t takers = (current_player == PLAYER_WHITE) ? white_pawn_attacked(piece[target]) & bitboards[B_PAWN]
+                                                               : black_pawn_attacked(piece[target]) & bitboards[W_PAWN];
+            if (takers) set_ep_square(target);
+        }
+    }
+
+    // Next player's turn
+    current_player = (current_player + 1) % 2;
+    hash_key ^= pgm_read_bitboard(&zobrist_side);
+
+    return played;
+}
+
+
+/* Reversible moves */
+
+// Undo records of the moves made since the search or perft root
+undo_record undo_stack[MAX_PLY];
+uint8_t ply = 0;
+
+/* Plays a move from generate_legal and records what unmake_move needs to take it back */
+uint8_t make_move(uint16_t move) {
+
+    undo_record* u = &undo_stack[ply++];
+    uint8_t to = MOVE_TO(move);
+    uint8_t x, y;
+
+    u->move = move;
+    u->castle_flags = castle_flags;
+    u->ep_square = ep_square;
+    u->hash_key = hash_key;
+
+    if (MOVE_FLAG(move) == MOVE_EN_PASSANT) {
+        u->captured = (current_player == PLAYER_WHITE) ? B_PAWN : W_PAWN;
+    } else if (MOVE_FLAG(move) & MOVE_CAPTURE) {
+        rf_to_dp(to, &x, &y);
+        u->captured = board[x][y];
+    } else {
+        u->captured = EMPTY;
+    }
+
+    return apply_move(move);
+}
+
+/* Passes the turn without moving (for null-move pruning), recorded like a move */
+void make_null_move() {
+
+    undo_record* u = &undo_stack[ply++];
+
+    u->move = NULL_MOVE;
+    u->captured = EMPTY;
+    u->castle_flags = castle_flags;
+    u->ep_square = ep_square;
+    u->hash_key = hash_key;
+
+    set_ep_square(NO_SQUARE);
+
+    current_player = (current_player + 1) % 2;
+    hash_key ^= pgm_read_bitboard(&zobrist_side);
+}
+
+/* Takes back the last move played with make_move or make_null_move */
+void unmake_move() {
+
+    undo_record* u = &undo_stack[--ply];
+
+    // A pass leaves the board alone, so the check and attack state still holds
+    if (u->move == NULL_MOVE) {
+        current_player = (current_player + 1) % 2;
+        ep_square = u->ep_square;
+        hash_key = u->hash_key;
+        return;
+    }
+
+    uint8_t from = MOVE_FROM(u->move);
+    uint8_t to = MOVE_TO(u->move);
+    uint8_t flag = MOVE_FLAG(u->move);
+
+    // Back to the side that made the move
+    current_player = (current_player + 1) % 2;
+
+    uint8_t own_side = (current_player == PLAYER_WHITE) ? W_ALL : B_ALL;
+    uint8_t enemy_side = (own_side == W_ALL) ? B_ALL : W_ALL;
+
+    uint8_t px, py, qx, qy;
+    rf_to_dp(from, &px, &py);
+    rf_to_dp(to, &qx, &qy);
+
+    if (flag == MOVE_CASTLE_KINGSIDE || flag == MOVE_CASTLE_QUEENSIDE) {
+
+        // King back home, then the rook from beside it to its corner
+        uint8_t rook_from = (flag == MOVE_CASTLE_KINGSIDE) ? from + 3 : from - 4;
+        uint8_t rook_to = (flag == MOVE_CASTLE_KINGSIDE) ? from + 1 : from - 1;
+        uint8_t rx, ry, rcx, rcy;
+
+        rf_to_dp(rook_from, &rx, &ry);
+        rf_to_dp(rook_to, &rcx, &rcy);
+
+        move_piece(piece[to], piece[from], qx, qy, px, py, own_side, enemy_side);
+        move_piece(piece[rook_to], piece[rook_from], rcx, rcy, rx, ry, own_side, enemy_side);
+
+    } else {
+
+        // A promoted piece turns back into the pawn
+        if (flag & MOVE_PROMOTION) {
+            remove_piece(piece[to], qx, qy);
+            put_piece(piece[to], qx, qy, (current_player == PLAYER_WHITE) ? W_PAWN : B_PAWN);
+        }
+
+        move_piece(piece[to], piece[from], qx, qy, px, py, own_side, enemy_side);
+
+        // Return the taken piece (beside the mover after en passant)
+        if (flag == MOVE_EN_PASSANT) {
+            put_piece(piece[(current_player == PLAYER_WHITE) ? to - BOARD_SIZE : to + BOARD_SIZE], qx, py, u->captured);
+        } else if (u->captured != EMPTY) {
+            put_piece(piece[to], qx, qy, u->captured);
+        }
+    }
+
+    castle_flags = u->castle_flags;
+    ep_square = u->ep_square;
+    hash_key = u->hash_key;
+}
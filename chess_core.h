@@ -0,0 +1,316 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+#ifndef chess_core_h
+#define chess_core_h
+
+#include <stdint.h>
+#include "sliders.h"
+
+/* Board size constraints */
+
+#define BOARD_SIZE 8
+
+/* Piece type constants */
+
+#define EMPTY 0
+#define W_PAWN 1
+#define W_KNIGHT 2
+#define W_BISHOP 3
+#define W_ROOK 4
+#define W_QUEEN 5
+#define W_KING 6
+#define B_PAWN 7
+#define B_KNIGHT 8
+#define B_BISHOP 9
+#define B_ROOK 10
+#define B_QUEEN 11
+#define B_KING 12
+#define W_ALL 13
+#define B_ALL 14
+#define WB_ALL 15
+
+/* Helper functions */
+
+uint8_t dp_to_rf(uint8_t x, uint8_t y);
+void rf_to_dp(uint8_t rf, uint8_t* x, uint8_t* y);
+
+/* Board initialisation */
+
+void init_board(const char* board_rep);
+uint8_t load_fen(const char* fen);
+
+/* Move square computations */
+
+uint64_t king_attacked(uint64_t king_loc);
+uint64_t compute_king_incomplete(uint64_t king_loc, uint64_t own_side);
+
+
+uint64_t knight_attacked(uint64_t knight_loc);
+uint64_t knight_moveable(uint64_t knight_loc, uint64_t own_side);
+
+uint64_t white_pawn_attacked(uint64_t pawn_loc);
+uint64_t white_pawn_moveable(uint64_t pawn_loc);
+
+uint64_t black_pawn_attacked(uint64_t pawn_loc);
+uint64_t black_pawn_moveable(uint64_t pawn_loc);
+
+// Shift based versions the per-square tables replaced, on the byte steps of
+// shifts.h. The pawn ones stay in use for whole sets of pawns, which they
+// cover in one pass where the tables take a lookup per pawn.
+uint64_t king_attacked_shift(uint64_t king_loc);
+uint64_t knight_attacked_shift(uint64_t knight_loc);
+uint64_t white_pawn_attacked_shift(uint64_t pawn_loc);
+uint64_t black_pawn_attacked_shift(uint64_t pawn_loc);
+
+uint64_t rook_moveable(uint64_t rook_loc, uint64_t own_side, uint64_t all_pieces);
+
+uint64_t bishop_moveable(uint64_t bishop_loc, uint64_t own_side, uint64_t all_pieces);
+
+uint64_t queen_moveable(uint64_t queen_loc, uint64_t own_side, uint64_t all_pieces);
+
+/* "King danger" square computations */
+
+// Squares one side attacks, by piece group. Sliders see through the enemy king,
+// so a king cannot step back along a ray it is being checked on.
+typedef struct {
+    uint64_t pawns;
+    uint64_t knights;
+    uint64_t king;
+    uint64_t diagonal;                  // Bishops and queens
+    uint64_t straight;                  // Rooks and queens
+    uint64_t all;
+} attack_map;
+
+// Bit for a piece type in the types argument of update_attacks
+#define TYPE_BIT(type) ((uint16_t) 1 << (type))
+
+void init_attacks();
+void update_attacks(uint64_t squares, uint16_t types);
+const attack_map* get_attacks(uint8_t side);
+
+uint64_t compute_white_attacked_minus_black_king();
+uint64_t compute_black_attacked_minus_white_king();
+
+/* In-check capture and push mask computation */
+
+void is_white_checked(uint64_t king_loc, uint64_t* capture_mask, uint64_t* push_mask);
+void is_black_checked(uint64_t king_loc, uint64_t* capture_mask, uint64_t* push_mask);
+uint8_t is_double_checked(uint64_t capture_mask);
+
+/* Castling */
+
+uint64_t castle_set_white();
+uint64_t castle_set_black();
+void castle(uint64_t castle_square);
+
+/* En passant */
+
+// ep_square value when the last move was not a double pawn step
+#define NO_SQUARE 64
+
+/* Check and pin state of one side, worked out once per position */
+
+typedef struct {
+    uint64_t checkers;                  // Enemy pieces giving check
+    uint64_t check_mask;                // Squares that capture or block a single check (all if none)
+    uint64_t pinned;                    // Own pieces pinned to the king
+    uint64_t pin_ray[BOARD_SIZE];       // Line each pinned piece may stay on, pinner included
+    uint8_t pin_square[BOARD_SIZE];     // Rank-file index of each pinned piece
+    uint8_t pins;
+} check_info;
+
+const check_info* get_check_info(uint8_t side);
+void reset_check_info();
+uint64_t pin_mask(const check_info* info, uint64_t pieces);
+
+/* Piece pinned to king mask computation */
+
+uint64_t compute_pin_mask_white(uint64_t piece);
+uint64_t compute_pin_mask_black(uint64_t piece);
+
+uint64_t masks_white(uint64_t piece);
+uint64_t masks_black(uint64_t piece);
+
+/* Representational piece movement */
+
+void move_piece(uint64_t p, uint64_t q, uint8_t px, uint8_t py, uint8_t qx, uint8_t qy, uint8_t own_side, uint8_t enemy_side);
+uint64_t generate_moves(uint64_t piece_loc, uint8_t piece_type);
+void remove_piece(uint64_t piece_loc, uint8_t x, uint8_t y);
+void put_piece(uint64_t piece_loc, uint8_t x, uint8_t y, uint8_t type);
+uint64_t take_changed_squares();
+
+/* Position hashing */
+
+uint64_t compute_hash_key();
+uint64_t compute_pawn_key();
+uint8_t play_move(uint8_t rf_from, uint8_t rf_to);
+
+/* Material and piece-square score */
+
+// Phase with every minor and major piece on the board (a pure middlegame)
+#define MAX_PHASE 24
+
+void compute_score(int16_t* mg, int16_t* eg, uint8_t* phase);
+
+/* Legal move lists */
+
+// Most legal moves any reachable position has
+#define MAX_MOVES 218
+
+// 16-bit move: from square in bits 0-5, to square in bits 6-11, flag in bits 12-15
+#define MOVE(from, to, flag) ((uint16_t) ((from) | ((to) << 6) | ((uint16_t) (flag) << 12)))
+#define MOVE_FROM(move) ((move) & 0x3F)
+#define MOVE_TO(move) (((move) >> 6) & 0x3F)
+#define MOVE_FLAG(move) ((move) >> 12)
+
+typedef struct {
+    uint16_t moves[MAX_MOVES];
+    uint8_t count;
+} move_list;
+
+uint8_t generate_legal(move_list* list);
+uint8_t legal_destinations(uint64_t* destinations);
+uint8_t side_has_legal_move();
+uint8_t apply_move(uint16_t move);
+
+/* Staged move generation */
+
+// Kinds of move for generate_kinds. Promotions count as captures, castling as quiet.
+#define GEN_CAPTURES 1
+#define GEN_QUIETS 2
+#define GEN_ALL (GEN_CAPTURES | GEN_QUIETS)
+
+// Keys returned by capture_order (higher first)
+#define ORDER_CAPTURE 100               // Plus 8 per victim type, less the attacker type
+#define ORDER_QUEEN_PROMOTION 250
+
+// Most hints a move_picker takes
+#define MAX_HINTS 2
+
+// Phases of a move_picker
+enum {
+    PICK_CAPTURES,
+    PICK_CAPTURES_NEXT,
+    PICK_HINTS_NEXT,
+    PICK_QUIETS,
+    PICK_QUIETS_NEXT,
+    PICK_DONE
+};
+
+// Hands out the moves of a position a phase at a time: captures and
+// promotions best first, then the caller's hints, then the other quiet moves.
+typedef struct {
+    move_list list;
+    uint8_t next;
+    uint8_t phase;
+    uint16_t hints[MAX_HINTS];
+} move_picker;
+
+uint8_t generate_kinds(move_list* list, uint8_t kinds, uint64_t pieces);
+uint8_t capture_order(uint16_t move);
+uint8_t is_legal_quiet(uint16_t move, move_list* scratch);
+void init_picker(move_picker* picker, const uint16_t* hints, uint8_t count);
+uint16_t pick_move(move_picker* picker);
+
+/* Reversible moves */
+
+// Deepest line make_move can stack up
+#ifdef __AVR__
+#define MAX_PLY 32
+#else
+#define MAX_PLY 128
+#endif
+
+// What unmake_move needs beyond the move itself
+typedef struct {
+    uint16_t move;
+    uint8_t captured;                   // Piece type taken, EMPTY if none
+    uint8_t castle_flags;
+    uint8_t ep_square;
+    uint64_t hash_key;
+} undo_record;
+
+// Move recorded by make_null_move (a1 to a1, never legal)
+#define NULL_MOVE 0
+
+uint8_t make_move(uint16_t move);
+void make_null_move();
+void unmake_move();
+
+// Rank lookup table indexes
+enum {
+    RANK_1, RANK_2, RANK_3, RANK_4,
+    RANK_5, RANK_6, RANK_7, RANK_8
+};
+
+// File lookup table indexes
+enum {
+    FILE_A, FILE_B, FILE_C, FILE_D,
+    FILE_E, FILE_F, FILE_G, FILE_H
+};
+
+enum {
+    CASTLE_WHITE_KINGSIDE,
+    CASTLE_WHITE_QUEENSIDE,
+    CASTLE_BLACK_KINGSIDE,
+    CASTLE_BLACK_QUEENSIDE
+};
+
+enum {
+    PLAYER_WHITE,
+    PLAYER_BLACK
+};
+
+// Kinds of move reported by play_move
+enum {
+    PLAYED_NORMAL,
+    PLAYED_CASTLE,
+    PLAYED_EN_PASSANT
+};
+
+// Move flags. Castling moves go king square to king square; promotions add
+// the piece (knight, bishop, rook, queen) to MOVE_PROMOTION and may be captures.
+enum {
+    MOVE_QUIET = 0,
+    MOVE_DOUBLE_PUSH = 1,
+    MOVE_CASTLE_KINGSIDE = 2,
+    MOVE_CASTLE_QUEENSIDE = 3,
+    MOVE_CAPTURE = 4,
+    MOVE_EN_PASSANT = 5,
+    MOVE_PROMOTION = 8
+};
+
+enum {
+    PROMOTE_KNIGHT,
+    PROMOTE_BISHOP,
+    PROMOTE_ROOK,
+    PROMOTE_QUEEN
+};
+
+/* Game state (see chess_core.c) */
+
+extern uint8_t current_player;
+extern uint8_t castle_flags;
+extern uint8_t board[BOARD_SIZE][BOARD_SIZE];
+extern uint64_t bitboards[WB_ALL + 1];
+extern uint64_t piece[BOARD_SIZE * BOARD_SIZE];
+extern uint8_t ep_square;
+extern uint64_t hash_key;
+extern uint64_t pawn_key;
+extern int16_t score_mg;
+extern int16_t score_eg;
+extern uint8_t score_phase;
+extern undo_record undo_stack[MAX_PLY];
+extern uint8_t ply;
+
+/* Lookup tables */
+
+extern const uint64_t clear_rank[BOARD_SIZE];
+extern const uint64_t mask_rank[BOARD_SIZE];
+extern const uint64_t clear_file[BOARD_SIZE];
+extern const uint64_t mask_file[BOARD_SIZE];
+
+#endif
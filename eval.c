@@ -0,0 +1,47 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+#include <stdint.h>
+#include "chess_core.h"
+#include "progmem.h"
+#include "pawns.h"
+#include "eval.h"
+
+// Middlegame share (out of 128) by game phase, to blend with shifts rather than
+// a division
+static const uint8_t taper_weight[MAX_PHASE + 1] PROGMEM = {
+      0,   5,  11,  16,  21,  27,  32,  37,  43,  48,  53,  59,  64,
+     69,  75,  80,  85,  91,  96, 101, 107, 112, 117, 123, 128
+};
+
+/* Blends middlegame and endgame scores by the phase, for the side to move */
+static int16_t taper(int16_t mg, int16_t eg, uint8_t phase) {
+
+    // Early promotions can push the phase past a full board
+    if (phase > MAX_PHASE) phase = MAX_PHASE;
+
+    uint8_t w = pgm_read_byte(&taper_weight[phase]);
+    int16_t score = ((int32_t) mg * w + (int32_t) eg * (128 - w)) >> 7;
+
+    return (current_player == PLAYER_WHITE) ? score : -score;
+}
+
+/* Evaluation of the current position from the incrementally kept score and
+ * the pawn structure table */
+int16_t evaluate() {
+    int16_t mg, eg;
+    pawn_score(&mg, &eg);
+    return taper(score_mg + mg, score_eg + eg, score_phase);
+}
+
+/* Evaluation of the current position from the bitboards alone */
+int16_t evaluate_from_scratch() {
+    int16_t mg, eg;
+    int16_t pawns_mg, pawns_eg;
+    uint8_t phase;
+    compute_score(&mg, &eg, &phase);
+    compute_pawn_score(&pawns_mg, &pawns_eg);
+    return taper(mg + pawns_mg, eg + pawns_eg, phase);
+}
@@ -0,0 +1,26 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+#ifndef eval_h
+#define eval_h
+
+#include <stdint.h>
+
+/* Static evaluation.
+ *
+ * The material and piece-square score is kept up to date by the piece
+ * movement functions (score_mg, score_eg and score_phase in chess_core), so
+ * evaluate() only adds the pawn structure score (mostly from its table, see
+ * pawns.h) and blends the middlegame and endgame parts by the phase.
+ * evaluate_from_scratch() works the same score out from the bitboards, as a
+ * reference for the incremental one.
+ *
+ * Scores are in centipawns from the side to move's point of view.
+ */
+
+int16_t evaluate();
+int16_t evaluate_from_scratch();
+
+#endif
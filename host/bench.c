@@ -0,0 +1,303 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+/* Kernel cross-checks and cycle benchmarks (host build only).
+ *
+ * Every alternative kernel is first compared against the original on random
+ * inputs, then run_benchmarks() reports average cycles per call.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "chess_core.h"
+#include "mailbox.h"
+#include "see.h"
+#include "eval.h"
+#include "pawns.h"
+#include "bench.h"
+
+#define CHECK_INPUTS 1000000
+
+// Length of the replayed game for the evaluation benchmark (NULL_MOVE restarts it)
+#define REPLAY_PLIES 100000
+#define REPLAY_GAME_PLIES 300
+
+#define START_FEN "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"
+
+static int failures = 0;
+
+// Defeats dead code elimination of the timed evaluations
+static volatile int32_t bench_sink_eval;
+
+static void check(const char* name, uint64_t expected, uint64_t got, uint64_t loc, uint64_t occ) {
+    if (expected != got && failures++ < 10) {
+        printf("%s mismatch: loc %016llx occ %016llx expected %016llx got %016llx\n", name,
+               (unsigned long long) loc, (unsigned long long) occ,
+               (unsigned long long) expected, (unsigned long long) got);
+    }
+}
+
+static void check_sliders_pass() {
+    for (long i = 0; i < CHECK_INPUTS; i++) {
+        // One to three sliders on a random occupancy (sliders may or may not be in it)
+        uint64_t loc = 0;
+        uint8_t n = 1 + bench_random() % 3;
+        for (uint8_t k = 0; k < n; k++) loc |= (uint64_t) 1 << (bench_random() & 63);
+        uint64_t occ = bench_random() & bench_random();
+        if (i & 1) occ |= loc;
+
+        check("rook fill", rook_attacked_loop(loc, occ), rook_attacked_fill(loc, occ), loc, occ);
+        check("bishop fill", bishop_attacked_loop(loc, occ), bishop_attacked_fill(loc, occ), loc, occ);
+        check("rook table", rook_attacked_loop(loc, occ), rook_attacked_table(loc, occ), loc, occ);
+        check("bishop table", bishop_attacked_loop(loc, occ), bishop_attacked_table(loc, occ), loc, occ);
+        check("rook magic", rook_attacked_loop(loc, occ), rook_attacked_magic(loc, occ), loc, occ);
+        check("bishop magic", bishop_attacked_loop(loc, occ), bishop_attacked_magic(loc, occ), loc, occ);
+    }
+}
+
+static void check_sliders() {
+    // Once with the tables in PEXT order (when supported), once with magics
+    for (int pass = cpu_has_pext() ? 0 : 1; pass < 2; pass++) {
+        init_sliders_magic(pass == 0);
+        check_sliders_pass();
+    }
+    init_sliders_magic(cpu_has_pext());
+}
+
+static void check_leapers() {
+    for (long i = 0; i < CHECK_INPUTS; i++) {
+        // Any set of squares, from single pieces up to a full board
+        uint64_t loc = bench_random();
+        if (i & 1) loc &= bench_random() & bench_random();
+        if (i & 2) loc = (uint64_t) 1 << (loc & 63);
+
+        check("knight table", knight_attacked_shift(loc), knight_attacked(loc), loc, 0);
+        check("king table", king_attacked_shift(loc), king_attacked(loc), loc, 0);
+        check("white pawn table", white_pawn_attacked_shift(loc), white_pawn_attacked(loc), loc, 0);
+        check("black pawn table", black_pawn_attacked_shift(loc), black_pawn_attacked(loc), loc, 0);
+    }
+}
+
+// Test positions: castling, promotions, en passant and bare kings between them
+static const char* const walk_fens[] = {
+    START_FEN,
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "8/8/1k6/2b5/2pP4/8/5K2/8 b - d3 0 1"
+};
+
+#define WALK_FENS (sizeof(walk_fens) / sizeof(walk_fens[0]))
+
+/* Exchanges with known outcomes (pawn 100, knight 320, bishop 330, rook 500,
+ * queen 900) */
+
+typedef struct {
+    const char* fen;
+    const char* square;
+    uint8_t side;
+    int16_t value;
+} see_case;
+
+static const see_case see_cases[] = {
+    // Undefended knight
+    { "4k3/8/8/3n4/8/8/3R4/4K3 w - - 0 1", "d5", PLAYER_WHITE, 320 },
+    // Knight defended by a pawn: the rook is lost for it
+    { "4k3/8/4p3/3n4/8/8/3R4/4K3 w - - 0 1", "d5", PLAYER_WHITE, -180 },
+    // Doubled rooks: the rook behind makes recapturing lose, so black does not
+    { "3rk3/8/8/3r4/8/8/3R4/3R2K1 w - - 0 1", "d5", PLAYER_WHITE, 500 },
+    // Queen behind a bishop: bishop for two pawns
+    { "4k3/8/4p3/3p4/8/1B6/Q7/4K3 w - - 0 1", "d5", PLAYER_WHITE, -130 },
+    // Only the king defends, and the bishop covers the square, so it cannot
+    { "4k3/3n4/8/8/B7/8/8/3RK3 w - - 0 1", "d7", PLAYER_WHITE, 320 },
+    // Only the king defends, and nothing stops it taking back
+    { "4k3/3n4/8/8/8/8/8/3RK3 w - - 0 1", "d7", PLAYER_WHITE, -180 },
+    // En prise to the queen, but the pawn behind takes back
+    { "4k3/8/4p3/3p4/8/8/8/3QK3 w - - 0 1", "d5", PLAYER_WHITE, -800 },
+    // The same for black
+    { "1r2k3/8/8/8/8/1N6/P7/4K3 b - - 0 1", "b3", PLAYER_BLACK, -180 },
+    // Nothing to take, and nothing to take with
+    { "4k3/8/8/8/8/8/8/4K3 w - - 0 1", "d4", PLAYER_WHITE, 0 },
+    { "4k3/8/8/3n4/8/8/8/4K3 w - - 0 1", "d5", PLAYER_WHITE, 0 }
+};
+
+static void check_see_cases() {
+    for (size_t i = 0; i < sizeof(see_cases) / sizeof(see_cases[0]); i++) {
+        const see_case* c = &see_cases[i];
+        uint8_t sq = (c->square[1] - '1') * BOARD_SIZE + (c->square[0] - 'a');
+        load_fen(c->fen);
+        check("see", (uint16_t) c->value, (uint16_t) see(sq, c->side), i, sq);
+        check("see_ge at", 1, see_ge(sq, c->side, c->value), i, sq);
+        check("see_ge above", 0, see_ge(sq, c->side, c->value + 1), i, sq);
+    }
+}
+
+/* see_ge against see for a spread of thresholds, over positions from random
+ * games out of each of the test positions */
+static void check_see() {
+    move_list list;
+    check_see_cases();
+    for (int game = 0; game < 20; game++) {
+        load_fen(walk_fens[game % WALK_FENS]);
+        for (int move = 0; move < 100 && generate_legal(&list); move++) {
+            for (uint8_t sq = 0; sq < 64; sq++) {
+                for (uint8_t side = PLAYER_WHITE; side <= PLAYER_BLACK; side++) {
+                    int16_t value = see(sq, side);
+                    for (int16_t threshold = -1000; threshold <= 1000; threshold += 10) {
+                        check("see_ge", value >= threshold, see_ge(sq, side, threshold), sq, threshold);
+                    }
+                }
+            }
+            apply_move(list.moves[bench_random() % list.count]);
+        }
+    }
+}
+
+/* Both rules backends walked in step through the trees of a few positions,
+ * comparing the sets of legal moves at every node */
+
+static int by_move(const void* a, const void* b) {
+    return (int) *(const uint16_t*) a - (int) *(const uint16_t*) b;
+}
+
+static void walk_backends(uint8_t depth) {
+
+    move_list list, other;
+    generate_legal(&list);
+    mailbox_generate_legal(&other);
+
+    qsort(list.moves, list.count, sizeof(uint16_t), by_move);
+    qsort(other.moves, other.count, sizeof(uint16_t), by_move);
+    uint8_t same = (list.count == other.count);
+    for (uint8_t i = 0; same && i < list.count; i++) {
+        same = (list.moves[i] == other.moves[i]);
+    }
+    check("mailbox", list.count, same ? list.count : other.count, hash_key, depth);
+
+    if (depth == 0) return;
+
+    for (uint8_t i = 0; i < list.count; i++) {
+        make_move(list.moves[i]);
+        mailbox_make_move(list.moves[i]);
+        walk_backends(depth - 1);
+        mailbox_unmake_move();
+        unmake_move();
+    }
+}
+
+static void check_mailbox() {
+    for (size_t i = 0; i < WALK_FENS; i++) {
+        load_fen(walk_fens[i]);
+        mailbox_load_fen(walk_fens[i]);
+        walk_backends(3);
+    }
+}
+
+/* A long random game (restarted every few hundred plies or when it ends), so
+ * the replays below see the same moves */
+static uint16_t replay[REPLAY_PLIES];
+
+static void make_replay() {
+    move_list list;
+    uint16_t game = 0;
+    load_fen(START_FEN);
+    for (long i = 0; i < REPLAY_PLIES; i++) {
+        if (game++ == REPLAY_GAME_PLIES || !generate_legal(&list)) {
+            replay[i] = NULL_MOVE;
+            load_fen(START_FEN);
+            game = 0;
+        } else {
+            replay[i] = list.moves[bench_random() % list.count];
+            apply_move(replay[i]);
+        }
+    }
+}
+
+typedef int16_t (*evaluator)();
+
+/* Plays the replay through, evaluating after every move (or not, if eval is NULL).
+ * Returns total cycles. */
+static uint64_t time_replay(evaluator eval) {
+    int32_t acc = 0;
+    uint64_t cycles = 0;
+    load_fen(START_FEN);
+    for (long i = 0; i < REPLAY_PLIES; i++) {
+        if (replay[i] == NULL_MOVE) {
+            load_fen(START_FEN);
+            continue;
+        }
+        uint32_t start = bench_cycles();
+        apply_move(replay[i]);
+        if (eval) acc += eval();
+        cycles += bench_cycles() - start;
+    }
+    bench_sink_eval = acc;
+    return cycles;
+}
+
+/* Incremental against from-scratch evaluation over the replay */
+static void check_eval() {
+    load_fen(START_FEN);
+    for (long i = 0; i < REPLAY_PLIES; i++) {
+        if (replay[i] == NULL_MOVE) {
+            load_fen(START_FEN);
+            continue;
+        }
+        apply_move(replay[i]);
+        check("evaluate", (uint16_t) evaluate_from_scratch(), (uint16_t) evaluate(), i, replay[i]);
+    }
+}
+
+/* The pawn structure part of the evaluation alone, through the table or not */
+
+static int16_t pawns_from_table() {
+    int16_t mg, eg;
+    pawn_score(&mg, &eg);
+    return mg + eg;
+}
+
+static int16_t pawns_from_scratch() {
+    int16_t mg, eg;
+    compute_pawn_score(&mg, &eg);
+    return mg + eg;
+}
+
+static void bench_eval() {
+    uint64_t moves = time_replay(NULL);
+    uint64_t incremental = time_replay(evaluate) - moves;
+    uint64_t scratch = time_replay(evaluate_from_scratch) - moves;
+    printf("\n%-24s %8lu cycles (replaying %d plies)\n", "evaluate incremental",
+           (unsigned long) (incremental / REPLAY_PLIES), REPLAY_PLIES);
+    printf("%-24s %8lu cycles\n", "evaluate from scratch", (unsigned long) (scratch / REPLAY_PLIES));
+
+    uint64_t table = time_replay(pawns_from_table) - moves;
+    uint64_t fills = time_replay(pawns_from_scratch) - moves;
+    printf("%-24s %8lu cycles\n", "pawns from table", (unsigned long) (table / REPLAY_PLIES));
+    printf("%-24s %8lu cycles\n", "pawns from scratch", (unsigned long) (fills / REPLAY_PLIES));
+}
+
+static void print_result(const char* name, uint32_t cycles) {
+    printf("%-24s %8lu cycles\n", name, (unsigned long) cycles);
+}
+
+int main() {
+
+    // Sets up the square tables the original kernels rely on
+    load_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+
+    check_sliders();
+    check_leapers();
+    check_see();
+    check_mailbox();
+    make_replay();
+    check_eval();
+    printf("cross-check: %d mismatches\n\n", failures);
+
+    run_benchmarks(print_result);
+    bench_eval();
+
+    return failures ? 1 : 0;
+}
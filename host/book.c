@@ -0,0 +1,338 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+/* Opening book builder (host build only).
+ *
+ *   book [--plies N] [--bytes N] [--min N] [pgn ...] > book_data.h
+ *
+ * Reads games in PGN (from the files given, or standard input), follows the
+ * first N plies of each from the start position (default 16) and counts the
+ * games that played each move in each position. The commonest entries that fit
+ * in the flash budget (--bytes, default 8192) and were played at least --min
+ * times (default 1) are written out as a C header, sorted by book_key().
+ *
+ * Every game is followed from the standard start position. The rest of a game
+ * after a move that cannot be read is skipped.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "chess_core.h"
+#include "book.h"
+
+#define START_FEN "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"
+
+#define MAX_TOKEN 64
+
+typedef struct {
+    uint64_t key;
+    uint16_t move;
+    uint32_t count;
+} book_record;
+
+static book_record* records = 0;
+static size_t record_count = 0;
+static size_t record_room = 0;
+
+static uint32_t games = 0;
+static uint32_t skipped = 0;
+
+/* Move in standard algebraic notation (e.g. Nbd7, exd5, e8=Q, O-O) in the
+ * current position, or NULL_MOVE if no legal move matches */
+static uint16_t parse_san(const char* san) {
+
+    move_list list;
+    generate_legal(&list);
+
+    // Castling
+    if (strncmp(san, "O-O-O", 5) == 0 || strncmp(san, "0-0-0", 5) == 0) {
+        for (uint8_t i = 0; i < list.count; i++) {
+            if (MOVE_FLAG(list.moves[i]) == MOVE_CASTLE_QUEENSIDE) return list.moves[i];
+        }
+        return NULL_MOVE;
+    }
+    if (strncmp(san, "O-O", 3) == 0 || strncmp(san, "0-0", 3) == 0) {
+        for (uint8_t i = 0; i < list.count; i++) {
+            if (MOVE_FLAG(list.moves[i]) == MOVE_CASTLE_KINGSIDE) return list.moves[i];
+        }
+        return NULL_MOVE;
+    }
+
+    // Moving piece (as a white type), then the squares, captures and promotion
+    uint8_t type = W_PAWN;
+    const char* p = strchr("NBRQK", *san);
+    if (*san && p) {
+        type = W_KNIGHT + (p - "NBRQK");
+        san++;
+    }
+
+    char squares[8];
+    uint8_t n = 0;
+    int8_t promote = -1;
+    for (; *san; san++) {
+        if (*san == 'x' || *san == '+' || *san == '#' || *san == '!' || *san == '?') continue;
+        if (*san == '=' || strchr("NBRQ", *san)) {
+            const char* q = strchr("NBRQ", (*san == '=') ? san[1] : *san);
+            if (!q || !*q) return NULL_MOVE;
+            promote = PROMOTE_KNIGHT + (q - "NBRQ");
+            if (*san == '=') san++;
+            continue;
+        }
+        if (n == sizeof(squares)) return NULL_MOVE;
+        squares[n++] = *san;
+    }
+
+    // Destination last, anything before it tells apart the pieces that could go there
+    if (n < 2 || squares[n - 2] < 'a' || squares[n - 2] > 'h' || squares[n - 1] < '1' || squares[n - 1] > '8') {
+        return NULL_MOVE;
+    }
+    uint8_t to = (squares[n - 1] - '1') * BOARD_SIZE + (squares[n - 2] - 'a');
+    int8_t from_file = -1;
+    int8_t from_rank = -1;
+    for (uint8_t i = 0; i + 2 < n; i++) {
+        if (squares[i] >= 'a' && squares[i] <= 'h') from_file = squares[i] - 'a';
+        else if (squares[i] >= '1' && squares[i] <= '8') from_rank = squares[i] - '1';
+        else return NULL_MOVE;
+    }
+
+    uint16_t found = NULL_MOVE;
+    for (uint8_t i = 0; i < list.count; i++) {
+        uint16_t move = list.moves[i];
+        uint8_t from = MOVE_FROM(move);
+        uint8_t x, y;
+        rf_to_dp(from, &x, &y);
+
+        uint8_t moving = board[x][y];
+        if (moving >= B_PAWN) moving -= B_PAWN - W_PAWN;
+
+        if (moving != type || MOVE_TO(move) != to) continue;
+        if (from_file >= 0 && from % BOARD_SIZE != from_file) continue;
+        if (from_rank >= 0 && from / BOARD_SIZE != from_rank) continue;
+        if ((MOVE_FLAG(move) & MOVE_PROMOTION) ? (MOVE_FLAG(move) & PROMOTE_QUEEN) != promote : promote >= 0) continue;
+
+        // Two matches means the notation is ambiguous
+        if (found != NULL_MOVE) return NULL_MOVE;
+        found = move;
+    }
+
+    return found;
+}
+
+/* Counts one game playing a move in the current position */
+static void add_record(uint16_t move) {
+    if (record_count == record_room) {
+        record_room = record_room ? record_room * 2 : 4096;
+        records = realloc(records, record_room * sizeof(book_record));
+        if (!records) {
+            fprintf(stderr, "out of memory\n");
+            exit(1);
+        }
+    }
+    records[record_count].key = book_key();
+    records[record_count].move = move;
+    records[record_count++].count = 1;
+}
+
+/* Reads the next token of movetext or tags, skipping comments, variations and
+ * annotation glyphs. Tag pairs come back as "[". Returns 0 at the end. */
+static int next_token(FILE* in, char* token) {
+
+    int c;
+
+    for (;;) {
+        c = fgetc(in);
+        if (c == EOF) return 0;
+        if (isspace(c)) continue;
+
+        if (c == '{') {
+            while ((c = fgetc(in)) != EOF && c != '}');
+            continue;
+        }
+        if (c == ';' || c == '%') {
+            while ((c = fgetc(in)) != EOF && c != '\n');
+            continue;
+        }
+        if (c == '(') {
+            int depth = 1;
+            while (depth && (c = fgetc(in)) != EOF) {
+                if (c == '(') depth++;
+                if (c == ')') depth--;
+                if (c == '{') while ((c = fgetc(in)) != EOF && c != '}');
+            }
+            continue;
+        }
+        if (c == '[') {
+            while ((c = fgetc(in)) != EOF && c != ']') {
+                if (c == '"') while ((c = fgetc(in)) != EOF && c != '"');
+            }
+            strcpy(token, "[");
+            return 1;
+        }
+        break;
+    }
+
+    int n = 0;
+    do {
+        if (n < MAX_TOKEN - 1) token[n++] = c;
+        c = fgetc(in);
+    } while (c != EOF && !isspace(c) && !strchr("{}()[];", c));
+    if (c != EOF) ungetc(c, in);
+    token[n] = '\0';
+
+    return 1;
+}
+
+/* Adds the opening moves of every game in a PGN stream */
+static void read_games(FILE* in, const char* name, uint8_t plies) {
+
+    char text[MAX_TOKEN];
+    uint16_t ply = 0;
+    uint8_t in_game = 0;                // Moves of the current game are still being read
+    uint8_t has_moves = 0;
+
+    while (next_token(in, text)) {
+
+        // Tags start the next game
+        if (text[0] == '[') {
+            if (has_moves) {
+                in_game = 0;
+                has_moves = 0;
+            }
+            continue;
+        }
+
+        if (!has_moves) {
+            load_fen(START_FEN);
+            ply = 0;
+            in_game = 1;
+            has_moves = 1;
+            games++;
+        }
+
+        // Results end the game, move numbers and glyphs carry no move
+        if (!strcmp(text, "1-0") || !strcmp(text, "0-1") || !strcmp(text, "1/2-1/2") || !strcmp(text, "*")) {
+            has_moves = 0;
+            continue;
+        }
+
+        char* san = text;
+        while (isdigit((unsigned char) *san)) san++;
+        while (*san == '.') san++;
+        if (san != text && san[-1] != '.') san = text;
+        if (*san == '\0' || *san == '$') continue;
+
+        if (!in_game || ply >= plies) continue;
+
+        uint16_t move = parse_san(san);
+        if (move == NULL_MOVE) {
+            fprintf(stderr, "%s: game %lu: cannot read move %u (%s), skipping the rest\n",
+                    name, (unsigned long) games, ply + 1, san);
+            skipped++;
+            in_game = 0;
+            continue;
+        }
+
+        add_record(move);
+        apply_move(move);
+        ply++;
+    }
+}
+
+static int by_key_and_move(const void* a, const void* b) {
+    const book_record* x = a;
+    const book_record* y = b;
+    if (x->key != y->key) return (x->key < y->key) ? -1 : 1;
+    return (int) x->move - (int) y->move;
+}
+
+static int by_count(const void* a, const void* b) {
+    const book_record* x = a;
+    const book_record* y = b;
+    if (x->count != y->count) return (x->count > y->count) ? -1 : 1;
+    return by_key_and_move(a, b);
+}
+
+int main(int argc, char** argv) {
+
+    const char* name = argv[0];
+    uint8_t plies = 16;
+    unsigned long bytes = 8192;
+    unsigned long min_count = 1;
+
+    while (argc >= 3 && strncmp(argv[1], "--", 2) == 0) {
+        if (strcmp(argv[1], "--plies") == 0) {
+            plies = atoi(argv[2]);
+        } else if (strcmp(argv[1], "--bytes") == 0) {
+            bytes = strtoul(argv[2], NULL, 10);
+        } else if (strcmp(argv[1], "--min") == 0) {
+            min_count = strtoul(argv[2], NULL, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--plies N] [--bytes N] [--min N] [pgn ...]\n", name);
+            return 2;
+        }
+        argc -= 2;
+        argv += 2;
+    }
+
+    if (argc < 2) {
+        read_games(stdin, "stdin", plies);
+    }
+    for (int i = 1; i < argc; i++) {
+        FILE* in = fopen(argv[i], "r");
+        if (!in) {
+            perror(argv[i]);
+            return 1;
+        }
+        read_games(in, argv[i], plies);
+        fclose(in);
+    }
+
+    // Merge repeats of the same move in the same position
+    qsort(records, record_count, sizeof(book_record), by_key_and_move);
+    size_t n = 0;
+    for (size_t i = 0; i < record_count; i++) {
+        if (n && records[n - 1].key == records[i].key && records[n - 1].move == records[i].move) {
+            records[n - 1].count++;
+        } else {
+            records[n++] = records[i];
+        }
+    }
+
+    // Keep the commonest that fit, then put them back in key order for the probe
+    size_t limit = bytes / BOOK_ENTRY_BYTES;
+    if (limit > UINT16_MAX) limit = UINT16_MAX;
+    qsort(records, n, sizeof(book_record), by_count);
+    while (n && records[n - 1].count < min_count) n--;
+    if (n > limit) n = limit;
+    qsort(records, n, sizeof(book_record), by_key_and_move);
+
+    printf("/*  Author: Dulhan Jayalath\n"
+           " * Licence: This work is licensed under the Creative Commons Attribution License.\n"
+           " *           View this license at http://creativecommons.org/about/licenses/\n"
+           " */\n\n"
+           "/* Opening book (see book.h), written by host/book.c: %lu games, %u plies each,\n"
+           " * %lu entries in %lu bytes of flash. */\n\n"
+           "#ifndef book_data_h\n#define book_data_h\n\n"
+           "#include <stdint.h>\n#include \"progmem.h\"\n#include \"book.h\"\n\n"
+           "#define BOOK_ENTRIES %lu\n\n",
+           (unsigned long) games, plies, (unsigned long) n, (unsigned long) (n * BOOK_ENTRY_BYTES), (unsigned long) n);
+
+    // An empty book still needs an element for the array to be valid C
+    printf("static const book_entry book[%s] PROGMEM = {\n", n ? "BOOK_ENTRIES" : "1");
+    if (n == 0) printf("    { 0, 0, 0 }\n");
+    for (size_t i = 0; i < n; i++) {
+        uint32_t weight = (records[i].count > UINT16_MAX) ? UINT16_MAX : records[i].count;
+        printf("    { 0x%016llX, 0x%04X, %5lu }%s\n", (unsigned long long) records[i].key,
+               records[i].move, (unsigned long) weight, (i + 1 < n) ? "," : "");
+    }
+    printf("};\n\n#endif\n");
+
+    fprintf(stderr, "%lu games (%lu cut short), %lu entries, %lu bytes\n", (unsigned long) games,
+            (unsigned long) skipped, (unsigned long) n, (unsigned long) (n * BOOK_ENTRY_BYTES));
+
+    return 0;
+}
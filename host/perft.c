@@ -0,0 +1,211 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+/* Perft driver for the chess core (host build only).
+ *
+ *   perft <depth> [fen]      node count, divide breakdown and nodes per second
+ *   perft --suite [depth]    run the built-in reference suite (optionally capped)
+ *
+ * Either may be preceded by --hash <MB> to cache subtree counts by position.
+ *
+ * Moves are enumerated with generate_legal() and walked with make_move() and
+ * unmake_move(), and are listed in UCI notation (castling as e1g1, promotions
+ * as e7e8q). Built with RULES=mailbox, the same calls go to the 0x88 prototype
+ * (mailbox.h), which keeps no position hash, so --hash is refused.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "chess_core.h"
+#include "cache.h"
+#include "mailbox.h"
+
+#ifdef RULES_MAILBOX
+#define BACKEND "mailbox"
+#define load_fen mailbox_load_fen
+#define generate_legal mailbox_generate_legal
+#define make_move mailbox_make_move
+#define unmake_move mailbox_unmake_move
+#else
+#define BACKEND "bitboard"
+#endif
+
+#define START_FEN "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"
+
+/* Reference positions and published node counts */
+static const struct {
+    const char* name;
+    const char* fen;
+    uint8_t depth;
+    uint64_t nodes;
+} suite[] = {
+    { "start",                 START_FEN, 4, 197281 },
+    { "kiwipete",              "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 3, 97862 },
+    { "ep and rook pins",      "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 5, 674624 },
+    { "castling, promotions",  "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 3, 9467 },
+    { "promotion race",        "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 3, 62379 },
+    { "middlegame",            "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", 3, 89890 },
+    { "illegal ep (check)",    "3k4/3p4/8/K1P4r/8/8/8/8 b - - 0 1", 6, 1134888 },
+    { "illegal ep (pin)",      "8/8/4k3/8/2p5/8/B2P2K1/8 w - - 0 1", 6, 1015133 },
+    { "ep gives check",        "8/8/1k6/2b5/2pP4/8/5K2/8 b - d3 0 1", 6, 1440467 },
+    { "short castle check",    "5k2/8/8/8/8/8/8/4K2R w K - 0 1", 6, 661072 },
+    { "long castle check",     "3k4/8/8/8/8/8/8/R3K3 w Q - 0 1", 6, 803711 },
+    { "castling rights",       "r3k2r/1b4bq/8/8/8/8/7B/R3K2R w KQkq - 0 1", 4, 1274206 },
+    { "castling prevented",    "r3k2r/8/3Q4/8/8/5q2/8/R3K2R b KQkq - 0 1", 4, 1720476 },
+    { "promote out of check",  "2K2r2/4P3/8/8/8/8/8/3k4 w - - 0 1", 6, 3821001 },
+    { "discovered check",      "8/8/1P2K3/8/2n5/1q6/8/5k2 b - - 0 1", 5, 1004658 },
+    { "self stalemate",        "K1k5/8/P7/8/8/8/8/8 w - - 0 1", 6, 2217 },
+    { "stalemate and mate",    "8/8/2k5/5q2/5n2/8/5K2/8 b - - 0 1", 4, 23527 },
+};
+
+static uint64_t perft(uint8_t depth) {
+
+    uint64_t nodes = 0;
+    move_list list;
+
+    generate_legal(&list);
+
+    // Bulk count at the frontier
+    if (depth == 1) return list.count;
+    if (depth == 0) return 1;
+
+    if (cache_probe_perft(hash_key, depth, &nodes)) return nodes;
+
+    for (uint8_t i = 0; i < list.count; i++) {
+        make_move(list.moves[i]);
+        nodes += perft(depth - 1);
+        unmake_move();
+    }
+
+    cache_store_perft(hash_key, depth, nodes);
+
+    return nodes;
+}
+
+static double now_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* UCI text of a move, e.g. e2e4 or e7e8q */
+static void move_name(uint16_t move, char* out) {
+    out[0] = 'a' + MOVE_FROM(move) % BOARD_SIZE;
+    out[1] = '1' + MOVE_FROM(move) / BOARD_SIZE;
+    out[2] = 'a' + MOVE_TO(move) % BOARD_SIZE;
+    out[3] = '1' + MOVE_TO(move) / BOARD_SIZE;
+    out[4] = (MOVE_FLAG(move) & MOVE_PROMOTION) ? "nbrq"[MOVE_FLAG(move) & PROMOTE_QUEEN] : '\0';
+    out[5] = '\0';
+}
+
+/* Perft with a per-move breakdown at the root */
+static uint64_t divide(uint8_t depth) {
+
+    uint64_t total = 0;
+    move_list list;
+
+    generate_legal(&list);
+
+    for (uint8_t i = 0; i < list.count; i++) {
+        char name[6];
+        move_name(list.moves[i], name);
+        make_move(list.moves[i]);
+        uint64_t n = perft(depth - 1);
+        unmake_move();
+        printf("%s: %llu\n", name, (unsigned long long) n);
+        total += n;
+    }
+
+    return total;
+}
+
+static int run_suite(uint8_t max_depth) {
+
+    int failures = 0;
+    uint64_t all_nodes = 0;
+    double all_time = 0;
+
+    for (size_t i = 0; i < sizeof(suite) / sizeof(suite[0]); i++) {
+
+        if (!load_fen(suite[i].fen)) {
+            printf("%-22s bad FEN\n", suite[i].name);
+            failures++;
+            continue;
+        }
+
+        uint8_t depth = suite[i].depth;
+        int checked = 1;
+        if (max_depth && depth > max_depth) {
+            depth = max_depth;
+            checked = 0;
+        }
+
+        double t0 = now_seconds();
+        uint64_t nodes = perft(depth);
+        double dt = now_seconds() - t0;
+
+        all_nodes += nodes;
+        all_time += dt;
+
+        const char* verdict = "";
+        if (checked) {
+            verdict = (nodes == suite[i].nodes) ? "ok" : "FAIL";
+            if (nodes != suite[i].nodes) failures++;
+        }
+
+        printf("%-22s d%u %12llu (expected %12llu) %8.3fs %4s\n", suite[i].name, depth,
+               (unsigned long long) nodes, (unsigned long long) suite[i].nodes, dt, verdict);
+    }
+
+    printf("total %llu nodes in %.3fs (%.0f nodes/s, %s), %d failed\n",
+           (unsigned long long) all_nodes, all_time, all_time > 0 ? all_nodes / all_time : 0.0, BACKEND, failures);
+
+    return failures ? 1 : 0;
+}
+
+int main(int argc, char** argv) {
+
+    const char* name = argv[0];
+
+    if (argc >= 3 && strcmp(argv[1], "--hash") == 0) {
+#ifdef RULES_MAILBOX
+        fprintf(stderr, "the mailbox backend has no position hash to cache by\n");
+        return 2;
+#endif
+        if (!cache_init(atoi(argv[2]))) {
+            fprintf(stderr, "cannot allocate %s MB of cache\n", argv[2]);
+            return 2;
+        }
+        argc -= 2;
+        argv += 2;
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "--suite") == 0) {
+        return run_suite(argc >= 3 ? atoi(argv[2]) : 0);
+    }
+
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s [--hash MB] <depth> [fen]\n       %s [--hash MB] --suite [max depth]\n", name, name);
+        return 2;
+    }
+
+    uint8_t depth = atoi(argv[1]);
+    const char* fen = (argc >= 3) ? argv[2] : START_FEN;
+
+    if (depth == 0 || depth > MAX_PLY || !load_fen(fen)) {
+        fprintf(stderr, "bad depth or FEN\n");
+        return 2;
+    }
+
+    double t0 = now_seconds();
+    uint64_t nodes = divide(depth);
+    double dt = now_seconds() - t0;
+
+    printf("\nnodes %llu\ntime %.3fs\nnps %.0f\n", (unsigned long long) nodes, dt, dt > 0 ? nodes / dt : 0.0);
+
+    return 0;
+}
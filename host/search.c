@@ -0,0 +1,121 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+/* Search driver for the chess core (host build only).
+ *
+ *   search [--nodes N] [--time MS] <depth> [fen]
+ *       best move, score, depth reached, nodes and nodes per second
+ *   search [--nodes N] [--time MS] [--book] --game <plies> <depth> [fen]
+ *       plays the engine against itself and lists the moves in UCI notation
+ *
+ * The budget options mirror what the device passes to search(). With --book
+ * the game takes book moves while there are any, as the device does; they are
+ * marked with a *.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "chess_core.h"
+#include "search.h"
+#include "book.h"
+
+#define START_FEN "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"
+
+static double now_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint32_t clock_ms() {
+    return (uint32_t) (now_seconds() * 1000);
+}
+
+/* UCI text of a move, e.g. e2e4 or e7e8q */
+static void move_name(uint16_t move, char* out) {
+    out[0] = 'a' + MOVE_FROM(move) % BOARD_SIZE;
+    out[1] = '1' + MOVE_FROM(move) / BOARD_SIZE;
+    out[2] = 'a' + MOVE_TO(move) % BOARD_SIZE;
+    out[3] = '1' + MOVE_TO(move) / BOARD_SIZE;
+    out[4] = (MOVE_FLAG(move) & MOVE_PROMOTION) ? "nbrq"[MOVE_FLAG(move) & PROMOTE_QUEEN] : '\0';
+    out[5] = '\0';
+}
+
+int main(int argc, char** argv) {
+
+    const char* name = argv[0];
+    search_limits limits = { 0, 0, 0, clock_ms };
+    uint16_t game_plies = 0;
+    uint8_t use_book = 0;
+
+    while (argc >= 3 && strncmp(argv[1], "--", 2) == 0) {
+        if (strcmp(argv[1], "--book") == 0) {
+            use_book = 1;
+            argc--;
+            argv++;
+            continue;
+        }
+        if (strcmp(argv[1], "--nodes") == 0) {
+            limits.nodes = strtoul(argv[2], NULL, 10);
+        } else if (strcmp(argv[1], "--time") == 0) {
+            limits.time_ms = atoi(argv[2]);
+        } else if (strcmp(argv[1], "--game") == 0) {
+            game_plies = atoi(argv[2]);
+        } else {
+            break;
+        }
+        argc -= 2;
+        argv += 2;
+    }
+
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s [--nodes N] [--time MS] [--book] [--game plies] <depth> [fen]\n", name);
+        return 2;
+    }
+
+    limits.depth = atoi(argv[1]);
+    const char* fen = (argc >= 3) ? argv[2] : START_FEN;
+
+    if (limits.depth == 0 || limits.depth >= MAX_PLY || !load_fen(fen)) {
+        fprintf(stderr, "bad depth or FEN\n");
+        return 2;
+    }
+
+    search_result result;
+    char text[6];
+
+    if (game_plies) {
+        uint64_t nodes = 0;
+        double t0 = now_seconds();
+        for (uint16_t i = 0; i < game_plies; i++) {
+            uint16_t move = use_book ? book_move((uint16_t) rand()) : NULL_MOVE;
+            uint8_t from_book = (move != NULL_MOVE);
+            if (!from_book) {
+                if (search(&limits, &result) == NULL_MOVE) break;
+                move = result.move;
+                nodes += result.nodes;
+            }
+            move_name(move, text);
+            printf("%s%s%s", i ? " " : "", text, from_book ? "*" : "");
+            fflush(stdout);
+            apply_move(move);
+        }
+        double dt = now_seconds() - t0;
+        printf("\n\nnodes %llu\ntime %.3fs\nnps %.0f\n", (unsigned long long) nodes, dt, dt > 0 ? nodes / dt : 0.0);
+        return 0;
+    }
+
+    double t0 = now_seconds();
+    search(&limits, &result);
+    double dt = now_seconds() - t0;
+
+    move_name(result.move, text);
+    printf("bestmove %s\nscore %d\ndepth %u\nnodes %lu\ntime %.3fs\nnps %.0f\n", result.move ? text : "(none)",
+           result.score, result.depth, (unsigned long) result.nodes, dt, dt > 0 ? result.nodes / dt : 0.0);
+
+    return 0;
+}
@@ -0,0 +1,518 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+#include <stdint.h>
+#include "chess_core.h"
+#include "progmem.h"
+#include "mailbox.h"
+
+// Only built where something uses it: the benchmarks, and RULES=mailbox perft
+#if defined(BENCH) || defined(RULES_MAILBOX)
+
+// 0x88 square of a rank-file index and back
+#define SQ88(rf) ((rf) + ((rf) & ~7))
+#define RF(sq) (((sq) + ((sq) & 7)) >> 1)
+#define OFF_BOARD(sq) ((sq) & 0x88)
+#define NO_SQ88 0x88
+
+// A board byte: piece type, and where the piece is in its side's list
+#define TYPE(cell) ((cell) & 0x0F)
+#define SLOT(cell) ((cell) >> 4)
+#define SIDE(type) ((type) >= B_PAWN)
+
+// Steps between 0x88 squares: straight (0-3), diagonal (4-7), knight (8-15)
+static const int8_t steps[16] PROGMEM = {
+    1, -1, 16, -16,
+    15, 17, -15, -17,
+    14, 18, 31, 33, -14, -18, -31, -33
+};
+
+#define STRAIGHT 0
+#define DIAGONAL 4
+#define KNIGHT 8
+
+typedef struct {
+    uint16_t move;
+    uint8_t captured;                   // Piece type taken, EMPTY if none
+    uint8_t rights;
+    uint8_t ep;
+} mailbox_undo;
+
+static uint8_t cells[128];
+static uint8_t pieces[2][16];           // Squares of each side's pieces, king first
+static uint8_t piece_count[2];
+static uint8_t side;
+static uint8_t rights;                  // Castling rights, as castle_flags
+static uint8_t ep;                      // En passant target, NO_SQ88 if none
+static mailbox_undo history[MAX_PLY];
+static uint8_t depth;
+
+static int8_t step(uint8_t i) {
+    return (int8_t) pgm_read_byte(&steps[i]);
+}
+
+/* Adds a piece to the board and to the end of its side's list */
+static void put(uint8_t sq, uint8_t type) {
+    uint8_t s = SIDE(type);
+    uint8_t slot = piece_count[s]++;
+    pieces[s][slot] = sq;
+    cells[sq] = type | (slot << 4);
+}
+
+/* Takes a piece off, filling its place in the list with the last one (never the king's place) */
+static void take(uint8_t sq) {
+    uint8_t s = SIDE(TYPE(cells[sq]));
+    uint8_t slot = SLOT(cells[sq]);
+    uint8_t last = pieces[s][--piece_count[s]];
+    pieces[s][slot] = last;
+    cells[last] = TYPE(cells[last]) | (slot << 4);
+    cells[sq] = EMPTY;
+}
+
+static void shift(uint8_t from, uint8_t to) {
+    uint8_t cell = cells[from];
+    pieces[SIDE(TYPE(cell))][SLOT(cell)] = to;
+    cells[to] = cell;
+    cells[from] = EMPTY;
+}
+
+/* Whether a side attacks a square, looking out from the square */
+static uint8_t attacked(uint8_t sq, uint8_t by) {
+
+    uint8_t t = by ? B_PAWN - W_PAWN : 0;
+
+    // Pawns sit a rank behind the squares they attack
+    uint8_t behind = by ? sq + 16 : sq - 16;
+    if (!OFF_BOARD(behind + 1) && cells[behind + 1] && TYPE(cells[behind + 1]) == t + W_PAWN) return 1;
+    if (!OFF_BOARD(behind - 1) && cells[behind - 1] && TYPE(cells[behind - 1]) == t + W_PAWN) return 1;
+
+    for (uint8_t i = KNIGHT; i < KNIGHT + 8; i++) {
+        uint8_t from = sq + step(i);
+        if (!OFF_BOARD(from) && TYPE(cells[from]) == t + W_KNIGHT) return 1;
+    }
+
+    for (uint8_t i = STRAIGHT; i < DIAGONAL + 4; i++) {
+        int8_t d = step(i);
+        uint8_t slider = t + ((i < DIAGONAL) ? W_ROOK : W_BISHOP);
+
+        // The king one step away, then sliders along the ray
+        uint8_t from = sq + d;
+        if (OFF_BOARD(from)) continue;
+        if (TYPE(cells[from]) == t + W_KING) return 1;
+
+        while (!OFF_BOARD(from)) {
+            uint8_t type = TYPE(cells[from]);
+            if (type) {
+                if (type == slider || type == t + W_QUEEN) return 1;
+                break;
+            }
+            from += d;
+        }
+    }
+
+    return 0;
+}
+
+static void add(move_list* list, uint8_t from, uint8_t to, uint8_t flag) {
+    list->moves[list->count++] = MOVE(RF(from), RF(to), flag);
+}
+
+/* Adds a pawn move, as the four promotions onto the last rank */
+static void add_pawn(move_list* list, uint8_t from, uint8_t to, uint8_t flag) {
+    if ((to >> 4) == RANK_8 || (to >> 4) == RANK_1) {
+        for (uint8_t promote = PROMOTE_KNIGHT; promote <= PROMOTE_QUEEN; promote++) {
+            add(list, from, to, flag | MOVE_PROMOTION | promote);
+        }
+    } else {
+        add(list, from, to, flag);
+    }
+}
+
+/* Adds a step or slide onto an empty or enemy square, and says whether a slide may go on */
+static uint8_t add_target(move_list* list, uint8_t from, uint8_t to) {
+    uint8_t type = TYPE(cells[to]);
+    if (type == EMPTY) {
+        add(list, from, to, MOVE_QUIET);
+        return 1;
+    }
+    if (SIDE(type) != side) add(list, from, to, MOVE_CAPTURE);
+    return 0;
+}
+
+static void pawn_moves(move_list* list, uint8_t from) {
+
+    int8_t forward = side ? -16 : 16;
+    uint8_t start = side ? RANK_7 : RANK_2;
+
+    uint8_t to = from + forward;
+    if (!OFF_BOARD(to) && cells[to] == EMPTY) {
+        add_pawn(list, from, to, MOVE_QUIET);
+        if ((from >> 4) == start && cells[to + forward] == EMPTY) {
+            add(list, from, to + forward, MOVE_DOUBLE_PUSH);
+        }
+    }
+
+    for (int8_t across = -1; across <= 1; across += 2) {
+        to = from + forward + across;
+        if (OFF_BOARD(to)) continue;
+        if (to == ep) {
+            add(list, from, to, MOVE_EN_PASSANT);
+        } else if (cells[to] && SIDE(TYPE(cells[to])) != side) {
+            add_pawn(list, from, to, MOVE_CAPTURE);
+        }
+    }
+}
+
+static void castle_moves(move_list* list, uint8_t king) {
+
+    uint8_t home = side ? 0x74 : 0x04;
+    uint8_t rook = side ? B_ROOK : W_ROOK;
+    uint8_t kingside = side ? CASTLE_BLACK_KINGSIDE : CASTLE_WHITE_KINGSIDE;
+    uint8_t queenside = side ? CASTLE_BLACK_QUEENSIDE : CASTLE_WHITE_QUEENSIDE;
+
+    if (king != home || attacked(home, !side)) return;
+
+    // The square the king lands on is tested with the other moves
+    if ( (rights & (1 << kingside)) && TYPE(cells[home + 3]) == rook &&
+         !cells[home + 1] && !cells[home + 2] && !attacked(home + 1, !side) ) {
+        add(list, home, home + 2, MOVE_CASTLE_KINGSIDE);
+    }
+    if ( (rights & (1 << queenside)) && TYPE(cells[home - 4]) == rook &&
+         !cells[home - 1] && !cells[home - 2] && !cells[home - 3] && !attacked(home - 1, !side) ) {
+        add(list, home, home - 2, MOVE_CASTLE_QUEENSIDE);
+    }
+}
+
+/* Every move of the side to move, some of which may leave its king attacked */
+static void generate_pseudo(move_list* list) {
+
+    uint8_t t = side ? B_PAWN - W_PAWN : 0;
+
+    list->count = 0;
+
+    for (uint8_t i = 0; i < piece_count[side]; i++) {
+
+        uint8_t from = pieces[side][i];
+        uint8_t kind = TYPE(cells[from]) - t;
+        uint8_t first = STRAIGHT;
+        uint8_t last = DIAGONAL + 4;
+
+        switch (kind) {
+            case W_PAWN:
+                pawn_moves(list, from);
+                continue;
+
+            case W_KNIGHT:
+                first = KNIGHT;
+                last = KNIGHT + 8;
+                // Fall through
+            case W_KING:
+                for (uint8_t d = first; d < last; d++) {
+                    uint8_t to = from + step(d);
+                    if (!OFF_BOARD(to)) add_target(list, from, to);
+                }
+                if (kind == W_KING) castle_moves(list, from);
+                continue;
+
+            case W_BISHOP:
+                first = DIAGONAL;
+                break;
+
+            case W_ROOK:
+                last = DIAGONAL;
+                break;
+
+            default:
+                break;
+        }
+
+        for (uint8_t d = first; d < last; d++) {
+            int8_t s = step(d);
+            for (uint8_t to = from + s; !OFF_BOARD(to) && add_target(list, from, to); to += s);
+        }
+    }
+}
+
+/* Castling rights a move from or onto a square takes away */
+static uint8_t rights_lost(uint8_t sq) {
+    switch (sq) {
+        case 0x00: return 1 << CASTLE_WHITE_QUEENSIDE;
+        case 0x07: return 1 << CASTLE_WHITE_KINGSIDE;
+        case 0x04: return (1 << CASTLE_WHITE_KINGSIDE) | (1 << CASTLE_WHITE_QUEENSIDE);
+        case 0x70: return 1 << CASTLE_BLACK_QUEENSIDE;
+        case 0x77: return 1 << CASTLE_BLACK_KINGSIDE;
+        case 0x74: return (1 << CASTLE_BLACK_KINGSIDE) | (1 << CASTLE_BLACK_QUEENSIDE);
+        default: return 0;
+    }
+}
+
+/* Plays a move from mailbox_generate_legal, recording how to take it back */
+void mailbox_make_move(uint16_t move) {
+
+    uint8_t from = SQ88(MOVE_FROM(move));
+    uint8_t to = SQ88(MOVE_TO(move));
+    uint8_t flag = MOVE_FLAG(move);
+
+    mailbox_undo* u = &history[depth++];
+    u->move = move;
+    u->captured = EMPTY;
+    u->rights = rights;
+    u->ep = ep;
+
+    ep = NO_SQ88;
+
+    if (flag == MOVE_EN_PASSANT) {
+        uint8_t victim = side ? to + 16 : to - 16;
+        u->captured = TYPE(cells[victim]);
+        take(victim);
+    } else if (flag & MOVE_CAPTURE) {
+        u->captured = TYPE(cells[to]);
+        take(to);
+    }
+
+    shift(from, to);
+
+    if (flag & MOVE_PROMOTION) {
+        cells[to] = ((side ? B_KNIGHT : W_KNIGHT) + (flag & PROMOTE_QUEEN)) | (cells[to] & 0xF0);
+    } else if (flag == MOVE_CASTLE_KINGSIDE) {
+        shift(from + 3, from + 1);
+    } else if (flag == MOVE_CASTLE_QUEENSIDE) {
+        shift(from - 4, from - 1);
+    } else if (flag == MOVE_DOUBLE_PUSH) {
+        ep = (from + to) >> 1;
+    }
+
+    rights &= ~(rights_lost(from) | rights_lost(to));
+    side = !side;
+}
+
+/* Takes back the last move played with mailbox_make_move */
+void mailbox_unmake_move() {
+
+    mailbox_undo* u = &history[--depth];
+    uint8_t from = SQ88(MOVE_FROM(u->move));
+    uint8_t to = SQ88(MOVE_TO(u->move));
+    uint8_t flag = MOVE_FLAG(u->move);
+
+    side = !side;
+    rights = u->rights;
+    ep = u->ep;
+
+    if (flag & MOVE_PROMOTION) {
+        cells[to] = (side ? B_PAWN : W_PAWN) | (cells[to] & 0xF0);
+    } else if (flag == MOVE_CASTLE_KINGSIDE) {
+        shift(from + 1, from + 3);
+    } else if (flag == MOVE_CASTLE_QUEENSIDE) {
+        shift(from - 1, from - 4);
+    }
+
+    shift(to, from);
+
+    if (flag == MOVE_EN_PASSANT) {
+        put(side ? to + 16 : to - 16, u->captured);
+    } else if (u->captured) {
+        put(to, u->captured);
+    }
+}
+
+/* Checks and pins on the side to move's king, found by looking out from it once
+ * per position so that most moves are legal or not without being played */
+
+static uint8_t checkers;                // Enemy pieces giving check
+static uint8_t checker;                 // Square of one of them
+static int8_t check_step;               // Step from the king to a sliding checker, 0 for a knight or pawn
+static int8_t pin_step[16];             // Step from the king through each pinned piece, by list place, 0 if free
+
+static void find_checks_and_pins(uint8_t king) {
+
+    uint8_t t = side ? 0 : B_PAWN - W_PAWN;
+
+    checkers = 0;
+    check_step = 0;
+    for (uint8_t i = 0; i < 16; i++) pin_step[i] = 0;
+
+    // Enemy pawns sit a rank ahead of the king they attack
+    uint8_t ahead = side ? king - 16 : king + 16;
+    for (int8_t across = -1; across <= 1; across += 2) {
+        uint8_t from = ahead + across;
+        if (!OFF_BOARD(from) && TYPE(cells[from]) == t + W_PAWN) {
+            checkers++;
+            checker = from;
+        }
+    }
+
+    for (uint8_t i = KNIGHT; i < KNIGHT + 8; i++) {
+        uint8_t from = king + step(i);
+        if (!OFF_BOARD(from) && TYPE(cells[from]) == t + W_KNIGHT) {
+            checkers++;
+            checker = from;
+        }
+    }
+
+    // Along each ray: an enemy slider checks, or pins the one own piece in front of it
+    for (uint8_t i = STRAIGHT; i < DIAGONAL + 4; i++) {
+        int8_t d = step(i);
+        uint8_t slider = t + ((i < DIAGONAL) ? W_ROOK : W_BISHOP);
+        uint8_t own = NO_SQ88;
+
+        for (uint8_t sq = king + d; !OFF_BOARD(sq); sq += d) {
+            uint8_t type = TYPE(cells[sq]);
+            if (type == EMPTY) continue;
+            if (SIDE(type) == side) {
+                if (own != NO_SQ88) break;
+                own = sq;
+                continue;
+            }
+            if (type == slider || type == t + W_QUEEN) {
+                if (own == NO_SQ88) {
+                    checkers++;
+                    checker = sq;
+                    check_step = d;
+                } else {
+                    pin_step[SLOT(cells[own])] = d;
+                }
+            }
+            break;
+        }
+    }
+}
+
+/* Whether a square is on the ray out from the king in one direction */
+static uint8_t on_ray(uint8_t king, int8_t d, uint8_t to) {
+    for (uint8_t sq = king + d; !OFF_BOARD(sq); sq += d) {
+        if (sq == to) return 1;
+    }
+    return 0;
+}
+
+/* Whether a move onto a square answers a single check, by taking the checker or blocking */
+static uint8_t answers_check(uint8_t king, uint8_t to) {
+    if (to == checker) return 1;
+    if (check_step) {
+        for (uint8_t sq = king + check_step; sq != checker; sq += check_step) {
+            if (sq == to) return 1;
+        }
+    }
+    return 0;
+}
+
+/* Whether a move keeps the king safe, given the checks and pins of the position */
+static uint8_t legal(uint8_t king, uint16_t move) {
+
+    uint8_t from = SQ88(MOVE_FROM(move));
+    uint8_t to = SQ88(MOVE_TO(move));
+
+    // The king may not step onto an attacked square, nor back along a checking ray
+    if (from == king) {
+        uint8_t cell = cells[king];
+        cells[king] = EMPTY;
+        uint8_t safe = !attacked(to, !side);
+        cells[king] = cell;
+        return safe;
+    }
+
+    if (checkers > 1) return 0;
+
+    // En passant takes two pieces off one rank, so it is played out
+    if (MOVE_FLAG(move) == MOVE_EN_PASSANT) {
+        mailbox_make_move(move);
+        uint8_t safe = !attacked(pieces[!side][0], side);
+        mailbox_unmake_move();
+        return safe;
+    }
+
+    int8_t pin = pin_step[SLOT(cells[from])];
+    if (pin && !on_ray(king, pin, to)) return 0;
+
+    return checkers == 0 || answers_check(king, to);
+}
+
+/* Fills a list with the legal moves of the side to move, returning how many */
+uint8_t mailbox_generate_legal(move_list* list) {
+
+    // The king is first in its list
+    uint8_t king = pieces[side][0];
+
+    find_checks_and_pins(king);
+    generate_pseudo(list);
+
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < list->count; i++) {
+        if (legal(king, list->moves[i])) list->moves[n++] = list->moves[i];
+    }
+
+    return list->count = n;
+}
+
+/* Sets up the position from a FEN record (placement, side, castling, en passant) */
+uint8_t mailbox_load_fen(const char* fen) {
+
+    static const char names[] = "PNBRQKpnbrqk";
+
+    for (uint8_t sq = 0; sq < 128; sq++) cells[sq] = EMPTY;
+
+    // Placement, rank 8 first
+    uint8_t rank = RANK_8;
+    uint8_t file = FILE_A;
+    for (; *fen && *fen != ' '; fen++) {
+        if (*fen == '/') {
+            if (file != BOARD_SIZE || rank == RANK_1) return 0;
+            rank--;
+            file = FILE_A;
+        } else if (*fen >= '1' && *fen <= '8') {
+            file += *fen - '0';
+        } else {
+            uint8_t type = 0;
+            while (names[type] && names[type] != *fen) type++;
+            if (!names[type] || file >= BOARD_SIZE) return 0;
+            cells[rank * 16 + file++] = W_PAWN + type;
+        }
+        if (file > BOARD_SIZE) return 0;
+    }
+    if (rank != RANK_1 || file != BOARD_SIZE) return 0;
+
+    // Lists, kings first
+    piece_count[PLAYER_WHITE] = piece_count[PLAYER_BLACK] = 0;
+    for (uint8_t pass = 0; pass < 2; pass++) {
+        for (uint8_t sq = 0; sq < 128; sq++) {
+            uint8_t type = cells[sq];
+            if (OFF_BOARD(sq) || type == EMPTY) continue;
+            uint8_t king = (type == W_KING || type == B_KING);
+            if (king == !pass) put(sq, type);
+        }
+        if (pass == 0 && (piece_count[PLAYER_WHITE] != 1 || piece_count[PLAYER_BLACK] != 1)) return 0;
+    }
+
+    // Side to move
+    while (*fen == ' ') fen++;
+    side = (*fen == 'b') ? PLAYER_BLACK : PLAYER_WHITE;
+    if (*fen) fen++;
+
+    // Castling rights
+    while (*fen == ' ') fen++;
+    rights = 0;
+    for (; *fen && *fen != ' '; fen++) {
+        switch (*fen) {
+            case 'K': rights |= 1 << CASTLE_WHITE_KINGSIDE; break;
+            case 'Q': rights |= 1 << CASTLE_WHITE_QUEENSIDE; break;
+            case 'k': rights |= 1 << CASTLE_BLACK_KINGSIDE; break;
+            case 'q': rights |= 1 << CASTLE_BLACK_QUEENSIDE; break;
+            default: break;
+        }
+    }
+
+    // En passant target square
+    while (*fen == ' ') fen++;
+    ep = NO_SQ88;
+    if (fen[0] >= 'a' && fen[0] <= 'h' && (fen[1] == '3' || fen[1] == '6')) {
+        ep = (fen[1] - '1') * 16 + (fen[0] - 'a');
+    }
+
+    depth = 0;
+
+    return 1;
+}
+
+#endif
@@ -0,0 +1,37 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+#ifndef mailbox_h
+#define mailbox_h
+
+#include <stdint.h>
+#include "chess_core.h"
+
+/* 0x88 mailbox rules backend, a prototype for the host and the benchmarks.
+ *
+ * The same rules as chess_core with no 64-bit words: a 128-byte 0x88 board
+ * (square = rank * 16 + file, off the board whenever a bit of 0x88 is set)
+ * and a list of each side's pieces, king first. Each board byte holds the
+ * piece type in its low nibble and the piece's place in its list in the high
+ * one, so moving or taking a piece never searches the lists.
+ *
+ * Moves are the chess_core 16-bit moves (rank-file squares and the same
+ * flags), so move lists from either backend compare directly. Like
+ * chess_core, it finds the checks on the king and the pinned pieces once per
+ * position; a move is then kept or dropped by those, and only king moves (an
+ * attack test with the king lifted off) and en passant (played out) cost more.
+ *
+ * It keeps its own position, apart from the bitboards, and has no hash or
+ * evaluation, so the game and search cannot run on it: make perft
+ * RULES=mailbox runs perft on it, and the benchmarks time it against
+ * chess_core. Only built for those (BENCH or RULES_MAILBOX).
+ */
+
+uint8_t mailbox_load_fen(const char* fen);
+uint8_t mailbox_generate_legal(move_list* list);
+void mailbox_make_move(uint16_t move);
+void mailbox_unmake_move();
+
+#endif
@@ -0,0 +1,149 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+#include <stdint.h>
+#include "chess_core.h"
+#include "progmem.h"
+#include "bits.h"
+#include "shifts.h"
+#include "pawns.h"
+
+// Table entries (a power of two)
+#ifdef __AVR__
+#define PAWN_ENTRIES 32
+#else
+#define PAWN_ENTRIES 16384
+#endif
+
+/* Weights in centipawns */
+
+#define DOUBLED_MG (-10)
+#define DOUBLED_EG (-25)
+#define ISOLATED_MG (-10)
+#define ISOLATED_EG (-15)
+
+// Per own pawn on the rank in front of the king (and the one after) on its
+// own and neighbouring files
+#define SHELTER_NEAR 12
+#define SHELTER_FAR 6
+
+// Passed pawn bonus by rank, from the side's own end
+static const uint8_t passed_mg[BOARD_SIZE] PROGMEM = { 0, 5, 10, 15, 25, 40, 65, 0 };
+static const uint8_t passed_eg[BOARD_SIZE] PROGMEM = { 0, 10, 15, 25, 45, 75, 120, 0 };
+
+typedef struct {
+    uint32_t check;                     // Upper half of the pawn key
+    int16_t mg, eg;                     // Doubled, isolated and passed pawns
+    uint8_t king[2];                    // King squares the shelters are for
+    int8_t shelter[2];
+} pawn_entry;
+
+static pawn_entry pawn_table[PAWN_ENTRIES];
+
+/* Fills, spans and neighbouring files of a set of pawns, as seen by white
+ * (black's pawns are flipped over to be scored the same way) */
+
+static uint64_t north_fill(uint64_t b) {
+    b |= b << 8;
+    b |= b << 16;
+    return b | (b << 32);
+}
+
+static uint64_t south_fill(uint64_t b) {
+    b |= b >> 8;
+    b |= b >> 16;
+    return b | (b >> 32);
+}
+
+static uint64_t beside(uint64_t b) {
+    return east(b) | west(b);
+}
+
+/* Doubled, isolated and passed pawns of one side, its pawns facing north */
+static void structure(uint64_t own, uint64_t enemy, int16_t* mg, int16_t* eg) {
+
+    // Pawns with one of their own behind them on the file
+    uint8_t doubled = popcount(own & north(north_fill(own)));
+
+    // Pawns with none of their own on the neighbouring files
+    uint64_t files = south_fill(north_fill(own));
+    uint8_t isolated = popcount(own & ~beside(files));
+
+    // Pawns outside every enemy front span (the squares an enemy pawn can
+    // reach or attack on its way down), not counting those behind their own
+    uint64_t span = south(south_fill(enemy));
+    uint64_t passed = own & ~(span | beside(span)) & ~south(south_fill(own));
+
+    *mg = doubled * DOUBLED_MG + isolated * ISOLATED_MG;
+    *eg = doubled * DOUBLED_EG + isolated * ISOLATED_EG;
+
+    for_each_bit(sq, passed) {
+        uint8_t rank = sq / BOARD_SIZE;
+        *mg += pgm_read_byte(&passed_mg[rank]);
+        *eg += pgm_read_byte(&passed_eg[rank]);
+    }
+}
+
+/* Middlegame score of a side's own pawns standing in front of its king */
+static int8_t shelter(uint64_t king, uint64_t own) {
+    uint64_t zone = king | beside(king);
+    return SHELTER_NEAR * popcount(north(zone) & own) +
+           SHELTER_FAR * popcount(north(north(zone)) & own);
+}
+
+static uint8_t king_square(uint64_t king) {
+    return king ? lsb(king) : NO_SQUARE;
+}
+
+/* Pawn structure score of the current position, from the table when the pawns
+ * (and kings) have been seen before */
+void pawn_score(int16_t* mg, int16_t* eg) {
+
+    uint64_t white = bitboards[W_PAWN];
+    uint64_t black = __builtin_bswap64(bitboards[B_PAWN]);
+    pawn_entry* e = &pawn_table[pawn_key & (PAWN_ENTRIES - 1)];
+
+    if (e->check != (uint32_t) (pawn_key >> 32)) {
+        int16_t black_mg, black_eg;
+        structure(white, bitboards[B_PAWN], &e->mg, &e->eg);
+        structure(black, __builtin_bswap64(white), &black_mg, &black_eg);
+        e->mg -= black_mg;
+        e->eg -= black_eg;
+        e->check = pawn_key >> 32;
+        // Matches no king square (nor a missing king), so both shelters are redone
+        e->king[PLAYER_WHITE] = e->king[PLAYER_BLACK] = NO_SQUARE + 1;
+    }
+
+    // Kings move more often than pawns, so only their shelters are redone
+    uint8_t sq = king_square(bitboards[W_KING]);
+    if (e->king[PLAYER_WHITE] != sq) {
+        e->king[PLAYER_WHITE] = sq;
+        e->shelter[PLAYER_WHITE] = shelter(bitboards[W_KING], white);
+    }
+
+    sq = king_square(bitboards[B_KING]);
+    if (e->king[PLAYER_BLACK] != sq) {
+        e->king[PLAYER_BLACK] = sq;
+        e->shelter[PLAYER_BLACK] = shelter(__builtin_bswap64(bitboards[B_KING]), black);
+    }
+
+    *mg = e->mg + e->shelter[PLAYER_WHITE] - e->shelter[PLAYER_BLACK];
+    *eg = e->eg;
+}
+
+/* Pawn structure score of the current position worked out from scratch */
+void compute_pawn_score(int16_t* mg, int16_t* eg) {
+
+    uint64_t white = bitboards[W_PAWN];
+    uint64_t black = __builtin_bswap64(bitboards[B_PAWN]);
+    int16_t black_mg, black_eg;
+
+    structure(white, bitboards[B_PAWN], mg, eg);
+    structure(black, __builtin_bswap64(white), &black_mg, &black_eg);
+
+    *mg += shelter(bitboards[W_KING], white) - black_mg -
+           shelter(__builtin_bswap64(bitboards[B_KING]), black);
+    *eg -= black_eg;
+}
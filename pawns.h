@@ -0,0 +1,26 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+#ifndef pawns_h
+#define pawns_h
+
+#include <stdint.h>
+
+/* Pawn structure evaluation.
+ *
+ * Doubled, isolated and passed pawns are found set-wise from the two pawn
+ * bitboards with file fills and front spans, and each king is scored for the
+ * pawns sheltering it. The result depends on the pawns (and for the shelter,
+ * the king squares) alone, so it is kept in a small table under the pawn key
+ * (pawn_key in chess_core) and only worked out again when the pawns change.
+ *
+ * The table has a few dozen entries on the device and many thousands on the
+ * host. Scores are white less black, for the middlegame and the endgame.
+ */
+
+void pawn_score(int16_t* mg, int16_t* eg);
+void compute_pawn_score(int16_t* mg, int16_t* eg);
+
+#endif
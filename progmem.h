@@ -0,0 +1,38 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+#ifndef progmem_h
+#define progmem_h
+
+/* Flash-resident constant tables.
+ *
+ * On the AVR, tables marked PROGMEM stay in the 128 KB of flash and must be
+ * read through pgm_read_*. On the host build they are ordinary constants.
+ */
+
+#include <stdint.h>
+
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+
+/* avr-libc stops at 32-bit reads, so a bitboard is fetched as two halves */
+static inline uint64_t pgm_read_bitboard(const uint64_t* addr) {
+    union {
+        uint64_t bb;
+        uint32_t half[2];
+    } u;
+    u.half[0] = pgm_read_dword((const uint32_t*) addr);
+    u.half[1] = pgm_read_dword((const uint32_t*) addr + 1);
+    return u.bb;
+}
+#else
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t*) (addr))
+#define pgm_read_word(addr) (*(const uint16_t*) (addr))
+#define pgm_read_dword(addr) (*(const uint32_t*) (addr))
+#define pgm_read_bitboard(addr) (*(const uint64_t*) (addr))
+#endif
+
+#endif
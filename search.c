@@ -0,0 +1,378 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "chess_core.h"
+#include "eval.h"
+#include "search.h"
+
+// Moves of all plies on the current line, one after the other
+#ifdef __AVR__
+#define SEARCH_MOVES 320
+#else
+#define SEARCH_MOVES 4096
+#endif
+
+// Nodes between reads of the clock
+#define CLOCK_INTERVAL 256
+
+/* Move ordering keys (higher first), around those of capture_order */
+
+#define ORDER_ROOT_BEST 255
+#define ORDER_KILLER 90                 // Less 10 for the second killer
+#define ORDER_QUIET 0
+
+// Phases a frame generates its moves in, each only once the one before is spent
+enum {
+    PHASE_ALL,                          // Everything at once (the root, to put the last best move first)
+    PHASE_CAPTURES,
+    PHASE_KILLERS,
+    PHASE_QUIETS,
+    PHASE_DONE
+};
+
+// What a frame is waiting on while a child frame is searched
+enum {
+    WAIT_NULL_MOVE,
+    WAIT_MOVE
+};
+
+// Frame flags
+#define FRAME_QUIESCE 1                 // Standing pat on captures only
+#define FRAME_IN_CHECK 2
+#define FRAME_NO_NULL 4                 // Parent just passed, so do not pass again
+
+// State of one ply of the search
+typedef struct {
+    int16_t alpha, beta, best;
+    uint16_t move;                      // Move being searched
+    uint16_t first, next, end;          // This ply's slice of the move stack
+    int8_t depth;
+    uint8_t flags;
+    uint8_t wait;
+    uint8_t phase;
+    uint8_t searched;                   // Moves searched so far
+    uint8_t reduced;                    // Plies taken off the move being searched
+} search_frame;
+
+static search_frame frames[MAX_PLY];
+static uint16_t move_stack[SEARCH_MOVES];
+static uint8_t move_order[SEARCH_MOVES];
+static uint16_t killers[MAX_PLY][2];
+
+// Moves of the node being expanded, before they are copied onto the move stack
+static move_list generated;
+
+static const search_limits* budget;
+static uint32_t search_nodes;
+static uint32_t start_ms;
+static uint8_t stopped;
+static uint16_t root_move;
+
+/* Ordering key of a move from generate_legal at a given search ply */
+static uint8_t order_move(uint16_t move, uint8_t sp) {
+    uint8_t order = capture_order(move);
+    if (order) return order;
+    if (move == killers[sp][0]) return ORDER_KILLER;
+    if (move == killers[sp][1]) return ORDER_KILLER - 10;
+    return ORDER_QUIET;
+}
+
+/* Puts a generated move on a frame's slice of the move stack */
+static void push_move(search_frame* f, uint16_t move, uint8_t order) {
+    move_stack[f->end] = move;
+    move_order[f->end++] = order;
+}
+
+/* Adds the frame's next phase of moves to its slice of the move stack.
+ * Returns 0 if the stack has no room for them. */
+static uint8_t next_phase(search_frame* f, uint8_t sp) {
+
+    uint8_t i;
+
+    switch (f->phase) {
+
+        case PHASE_ALL:
+            generate_legal(&generated);
+            if (f->end + generated.count > SEARCH_MOVES) return 0;
+            for (i = 0; i < generated.count; i++) {
+                uint16_t move = generated.moves[i];
+                push_move(f, move, (move == root_move) ? ORDER_ROOT_BEST : order_move(move, sp));
+            }
+            f->phase = PHASE_DONE;
+            break;
+
+        case PHASE_CAPTURES:
+            generate_kinds(&generated, GEN_CAPTURES, ~(uint64_t) 0);
+            if (f->end + generated.count > SEARCH_MOVES) return 0;
+            for (i = 0; i < generated.count; i++) {
+                uint8_t order = capture_order(generated.moves[i]);
+                // Quiescence leaves out underpromotions
+                if ((f->flags & FRAME_QUIESCE) && order < ORDER_CAPTURE) continue;
+                push_move(f, generated.moves[i], order);
+            }
+            f->phase = (f->flags & FRAME_QUIESCE) ? PHASE_DONE : PHASE_KILLERS;
+            break;
+
+        case PHASE_KILLERS:
+            if (f->end + 2 > SEARCH_MOVES) return 0;
+            if (is_legal_quiet(killers[sp][0], &generated)) push_move(f, killers[sp][0], ORDER_KILLER);
+            if (is_legal_quiet(killers[sp][1], &generated)) push_move(f, killers[sp][1], ORDER_KILLER - 10);
+            f->phase = PHASE_QUIETS;
+            break;
+
+        case PHASE_QUIETS:
+            generate_kinds(&generated, GEN_QUIETS, ~(uint64_t) 0);
+            if (f->end + generated.count > SEARCH_MOVES) return 0;
+            for (i = 0; i < generated.count; i++) {
+                uint16_t move = generated.moves[i];
+                // Legal killers went out in the phase before
+                if (move != killers[sp][0] && move != killers[sp][1]) push_move(f, move, ORDER_QUIET);
+            }
+            f->phase = PHASE_DONE;
+            break;
+    }
+
+    return 1;
+}
+
+/* Whether the side to move has anything besides pawns and its king (null moves
+ * are unsound in pawn endings, where passing is often the best move) */
+static uint8_t has_pieces() {
+    uint8_t t = (current_player == PLAYER_WHITE) ? 0 : B_PAWN - W_PAWN;
+    return (bitboards[t + W_KNIGHT] | bitboards[t + W_BISHOP] |
+            bitboards[t + W_ROOK] | bitboards[t + W_QUEEN]) != 0;
+}
+
+/* Whether the position occurred earlier on the current line. Only positions
+ * with the same side to move since the last capture or pass can match. */
+static uint8_t is_repetition() {
+    uint8_t i = ply;
+    while (i >= 2) {
+        if (undo_stack[--i].move == NULL_MOVE || undo_stack[i].captured != EMPTY) return 0;
+        if (undo_stack[--i].move == NULL_MOVE || undo_stack[i].captured != EMPTY) return 0;
+        if (undo_stack[i].hash_key == hash_key) return 1;
+    }
+    return 0;
+}
+
+/* Counts a node and notes when the budget has run out */
+static uint8_t out_of_budget() {
+
+    search_nodes++;
+
+    if (budget->nodes && search_nodes >= budget->nodes) stopped = 1;
+
+    if (budget->time_ms && (search_nodes % CLOCK_INTERVAL) == 0 &&
+        budget->clock_ms() - start_ms >= budget->time_ms) stopped = 1;
+
+    return stopped;
+}
+
+/* Searches the current position to the given depth and returns its score,
+ * keeping the best root move in root_move. Frames stand in for recursion:
+ * entering a child pushes a frame and jumps to enter, and leaving pops back to
+ * the parent, which carries on from what it was waiting on.
+ */
+static int16_t negamax(int8_t depth, int16_t alpha, int16_t beta) {
+
+    uint8_t sp = 0;
+    search_frame* f = &frames[0];
+    search_frame* child;
+    int16_t value;
+
+    f->depth = depth;
+    f->alpha = alpha;
+    f->beta = beta;
+    f->flags = 0;
+    f->first = 0;
+
+enter:
+    if (out_of_budget() || (sp && is_repetition())) {
+        value = 0;
+        goto leave;
+    }
+
+    // The undo stack is full, so this is as deep as the line goes
+    if (ply >= MAX_PLY - 1) {
+        value = evaluate();
+        goto leave;
+    }
+
+    f->best = -SCORE_INFINITE;
+    f->searched = 0;
+    f->end = f->first;
+    if (get_check_info(current_player)->checkers) f->flags |= FRAME_IN_CHECK;
+
+    // Past the horizon only captures are searched, and the side to move may
+    // stand pat instead. In check every evasion is searched.
+    if (f->depth <= 0 && !(f->flags & FRAME_IN_CHECK)) {
+        f->flags |= FRAME_QUIESCE;
+        value = evaluate();
+        if (value >= f->beta) goto leave;
+        if (value > f->alpha) f->alpha = value;
+        f->best = value;
+    }
+
+    // Null move: if passing still fails high, a real move would too
+    if ( sp && f->depth >= 3 && !(f->flags & (FRAME_QUIESCE | FRAME_IN_CHECK | FRAME_NO_NULL)) &&
+         f->beta < SCORE_MATE_BOUND && has_pieces() ) {
+        f->wait = WAIT_NULL_MOVE;
+        make_null_move();
+        child = f + 1;
+        child->depth = f->depth - ((f->depth >= 6) ? 4 : 3);
+        child->alpha = -f->beta;
+        child->beta = -f->beta + 1;
+        child->flags = FRAME_NO_NULL;
+        child->first = f->end;
+        f = child;
+        sp++;
+        goto enter;
+    }
+
+moves:
+    f->next = f->first;
+    f->phase = (sp == 0) ? PHASE_ALL : PHASE_CAPTURES;
+
+next:
+    // Spent moves are dropped so the next phase reuses their room
+    while (f->next == f->end) {
+
+        if (f->phase == PHASE_DONE) {
+            // No legal move at all is mate or stalemate
+            if (f->searched == 0 && !(f->flags & FRAME_QUIESCE)) {
+                value = (f->flags & FRAME_IN_CHECK) ? -SCORE_MATE + sp : 0;
+            } else {
+                value = f->best;
+            }
+            goto leave;
+        }
+
+        f->next = f->end = f->first;
+
+        if (!next_phase(f, sp)) {
+            value = evaluate();
+            goto leave;
+        }
+    }
+
+    // Bring the best ordered remaining move to the front
+    {
+        uint16_t pick = f->next;
+        for (uint16_t i = pick + 1; i < f->end; i++) {
+            if (move_order[i] > move_order[pick]) pick = i;
+        }
+        uint16_t move = move_stack[pick];
+        uint8_t order = move_order[pick];
+        move_stack[pick] = move_stack[f->next];
+        move_order[pick] = move_order[f->next];
+        f->next++;
+        f->move = move;
+
+        make_move(move);
+
+        // Late quiet moves that do not give check are searched shallower first
+        f->reduced = 0;
+        if ( f->depth >= 3 && f->searched >= 3 && order == ORDER_QUIET &&
+             !(f->flags & FRAME_IN_CHECK) && !get_check_info(current_player)->checkers ) {
+            f->reduced = (f->searched >= 8) ? 2 : 1;
+        }
+    }
+
+search_move:
+    f->wait = WAIT_MOVE;
+    child = f + 1;
+    child->depth = f->depth - 1 - f->reduced;
+    child->alpha = -f->beta;
+    child->beta = -f->alpha;
+    child->flags = 0;
+    child->first = f->end;
+    f = child;
+    sp++;
+    goto enter;
+
+leave:
+    if (sp == 0) return value;
+
+    f = &frames[--sp];
+    value = -value;
+
+    if (f->wait == WAIT_NULL_MOVE) {
+        unmake_move();
+        if (stopped) goto leave;
+        if (value >= f->beta) {
+            value = f->beta;
+            goto leave;
+        }
+        goto moves;
+    }
+
+    // A reduced move that beats alpha is searched again at full depth
+    if (f->reduced && value > f->alpha && !stopped) {
+        f->reduced = 0;
+        goto search_move;
+    }
+
+    unmake_move();
+    if (stopped) goto leave;
+
+    f->searched++;
+
+    if (value > f->best) {
+        f->best = value;
+        if (value > f->alpha) {
+            f->alpha = value;
+            if (sp == 0) root_move = f->move;
+            if (value >= f->beta) {
+                // Remember quiet moves that refute, to try early in sibling positions
+                if ( !(MOVE_FLAG(f->move) & (MOVE_CAPTURE | MOVE_PROMOTION)) && killers[sp][0] != f->move ) {
+                    killers[sp][1] = killers[sp][0];
+                    killers[sp][0] = f->move;
+                }
+                goto leave;
+            }
+        }
+    }
+
+    goto next;
+}
+
+/* Searches for the best move of the side to move within the limits, deepening
+ * one ply at a time. Returns the move (NULL_MOVE if there is none). */
+uint16_t search(const search_limits* limits, search_result* result) {
+
+    budget = limits;
+    search_nodes = 0;
+    stopped = 0;
+    start_ms = budget->time_ms ? budget->clock_ms() : 0;
+    memset(killers, 0, sizeof(killers));
+
+    result->score = 0;
+    result->depth = 0;
+
+    // Fall back on the first legal move should the budget run out at once
+    generate_legal(&generated);
+    root_move = generated.count ? generated.moves[0] : NULL_MOVE;
+
+    if (root_move != NULL_MOVE) {
+        for (uint8_t depth = 1; depth <= budget->depth && ply + depth < MAX_PLY; depth++) {
+
+            int16_t score = negamax(depth, -SCORE_INFINITE, SCORE_INFINITE);
+            if (stopped) break;
+
+            result->score = score;
+            result->depth = depth;
+
+            // No point looking deeper once a forced mate is found
+            if (score >= SCORE_MATE_BOUND || score <= -SCORE_MATE_BOUND) break;
+        }
+    }
+
+    result->move = root_move;
+    result->nodes = search_nodes;
+
+    return root_move;
+}
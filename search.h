@@ -0,0 +1,47 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+#ifndef search_h
+#define search_h
+
+#include <stdint.h>
+
+/* Gary Chess: iterative-deepening negamax alpha-beta search.
+ *
+ * Each iteration walks the tree with make_move/unmake_move on the one game
+ * state. Per-ply state lives in a static array of small frames driven by a
+ * loop rather than recursion, and the moves of every ply share one static
+ * move stack, so the hardware stack stays shallow and nothing is copied per
+ * node. Captures are searched to quiescence; moves are tried captures first
+ * (most valuable victim, least valuable attacker), then killers, then the
+ * rest, with null-move pruning and late-move reductions.
+ *
+ * The search stops when the depth, node or time budget runs out and returns
+ * the best root move found so far.
+ */
+
+// Scores are in centipawns from the side to move's point of view. A mate in
+// n plies scores SCORE_MATE - n.
+#define SCORE_INFINITE 32000
+#define SCORE_MATE 30000
+#define SCORE_MATE_BOUND (SCORE_MATE - 256)
+
+typedef struct {
+    uint8_t depth;                      // Deepest iteration to run
+    uint32_t nodes;                     // Node budget, 0 for none
+    uint16_t time_ms;                   // Time budget, 0 for none
+    uint32_t (*clock_ms)();             // Millisecond clock, needed for time_ms
+} search_limits;
+
+typedef struct {
+    uint16_t move;                      // Best move, NULL_MOVE if there is no legal move
+    int16_t score;                      // Score of the last completed iteration
+    uint8_t depth;                      // Last completed iteration
+    uint32_t nodes;
+} search_result;
+
+uint16_t search(const search_limits* limits, search_result* result);
+
+#endif
@@ -0,0 +1,165 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+#include <stdint.h>
+#include "chess_core.h"
+#include "see.h"
+
+// Exchange values by piece type. The king outweighs everything, so taking with
+// it only pays when nothing can take it back.
+static const int16_t see_value[B_KING + 1] = {
+    0, 100, 320, 330, 500, 900, 20000,
+       100, 320, 330, 500, 900, 20000
+};
+
+/* Pieces of both sides attacking a square on the given occupancy */
+static uint64_t attackers_to(uint64_t target, uint64_t occupied) {
+    return (black_pawn_attacked(target) & bitboards[W_PAWN]) |
+           (white_pawn_attacked(target) & bitboards[B_PAWN]) |
+           (knight_attacked(target) & (bitboards[W_KNIGHT] | bitboards[B_KNIGHT])) |
+           (king_attacked(target) & (bitboards[W_KING] | bitboards[B_KING])) |
+           (bishop_attacked(target, occupied) & (bitboards[W_BISHOP] | bitboards[B_BISHOP] |
+                                                 bitboards[W_QUEEN] | bitboards[B_QUEEN])) |
+           (rook_attacked(target, occupied) & (bitboards[W_ROOK] | bitboards[B_ROOK] |
+                                               bitboards[W_QUEEN] | bitboards[B_QUEEN]));
+}
+
+/* Type of a side's least valuable piece among the attackers (EMPTY if none),
+ * leaving that piece's square in from */
+static uint8_t least_valuable(uint64_t attackers, uint8_t side, uint64_t* from) {
+    uint8_t t = (side == PLAYER_WHITE) ? 0 : B_PAWN - W_PAWN;
+    for (uint8_t type = W_PAWN; type <= W_KING; type++) {
+        uint64_t bb = attackers & bitboards[t + type];
+        if (bb) {
+            *from = bb & -bb;
+            return t + type;
+        }
+    }
+    return EMPTY;
+}
+
+/* Sliders uncovered on a square once a capturer of the given type has left it */
+static uint64_t xrays(uint64_t target, uint64_t occupied, uint8_t type) {
+    uint64_t att = 0;
+    if (type == W_PAWN || type == B_PAWN || type == W_BISHOP || type == B_BISHOP ||
+        type == W_QUEEN || type == B_QUEEN) {
+        att |= bishop_attacked(target, occupied) & (bitboards[W_BISHOP] | bitboards[B_BISHOP] |
+                                                    bitboards[W_QUEEN] | bitboards[B_QUEEN]);
+    }
+    if (type == W_ROOK || type == B_ROOK || type == W_QUEEN || type == B_QUEEN) {
+        att |= rook_attacked(target, occupied) & (bitboards[W_ROOK] | bitboards[B_ROOK] |
+                                                  bitboards[W_QUEEN] | bitboards[B_QUEEN]);
+    }
+    return att;
+}
+
+/* Piece type on a rank-file index */
+static uint8_t type_at(uint8_t sq) {
+    uint8_t x, y;
+    rf_to_dp(sq, &x, &y);
+    return board[x][y];
+}
+
+/* Material the side wins by starting the exchange on a square */
+int16_t see(uint8_t square, uint8_t side) {
+
+    uint64_t target = piece[square];
+    uint8_t victim = type_at(square);
+    uint64_t own = bitboards[(side == PLAYER_WHITE) ? W_ALL : B_ALL];
+
+    if (victim == EMPTY || (target & own)) return 0;
+
+    uint64_t occupied = bitboards[WB_ALL];
+    uint64_t attackers = attackers_to(target, occupied);
+    uint64_t from;
+    uint8_t attacker = least_valuable(attackers, side, &from);
+
+    if (attacker == EMPTY) return 0;
+
+    // gain[d] is what the side making capture d wins if the exchange stops after it
+    int16_t gain[32];
+    uint8_t d = 0;
+    gain[0] = see_value[victim];
+
+    for (;;) {
+        occupied ^= from;
+        attackers = (attackers | xrays(target, occupied, attacker)) & occupied;
+        side = !side;
+
+        // The piece that just took is now the one at stake
+        uint8_t taken = attacker;
+        attacker = least_valuable(attackers, side, &from);
+        if (attacker == EMPTY) break;
+
+        d++;
+        gain[d] = see_value[taken] - gain[d - 1];
+
+        // Further captures can only make this one worse, so if it already
+        // loses against stopping, the side stops here
+        if (gain[d] < -gain[d - 1]) {
+            d--;
+            break;
+        }
+    }
+
+    // Fold back: each side takes or stops, whichever leaves it better off
+    while (d) {
+        gain[d - 1] = -((-gain[d - 1] > gain[d]) ? -gain[d - 1] : gain[d]);
+        d--;
+    }
+
+    return gain[0];
+}
+
+/* Whether see(square, side) is at least the threshold, worked out only as far
+ * as needed */
+uint8_t see_ge(uint8_t square, uint8_t side, int16_t threshold) {
+
+    uint64_t target = piece[square];
+    uint8_t victim = type_at(square);
+    uint64_t own = bitboards[(side == PLAYER_WHITE) ? W_ALL : B_ALL];
+
+    if (victim == EMPTY || (target & own)) return threshold <= 0;
+
+    uint64_t occupied = bitboards[WB_ALL];
+    uint64_t attackers = attackers_to(target, occupied);
+    uint64_t from;
+    uint8_t attacker = least_valuable(attackers, side, &from);
+
+    if (attacker == EMPTY) return threshold <= 0;
+
+    // Even the piece taken for free falls short
+    int16_t swap = see_value[victim] - threshold;
+    if (swap < 0) return 0;
+
+    // Even losing the capturer for nothing still clears it
+    swap = see_value[attacker] - swap;
+    if (swap <= 0) return 1;
+
+    // res is the answer should the exchange stop now
+    uint8_t res = 1;
+    uint8_t stm = side;
+
+    for (;;) {
+        occupied ^= from;
+        attackers = (attackers | xrays(target, occupied, attacker)) & occupied;
+        stm = !stm;
+
+        attacker = least_valuable(attackers, stm, &from);
+        if (attacker == EMPTY) break;
+
+        // A king may only take when nothing can take it back
+        if (attacker == W_KING || attacker == B_KING) {
+            uint64_t others = attackers & bitboards[(stm == PLAYER_WHITE) ? B_ALL : W_ALL];
+            return others ? res : !res;
+        }
+
+        res = !res;
+        swap = see_value[attacker] - swap;
+        if (swap < res) break;
+    }
+
+    return res;
+}
@@ -0,0 +1,27 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+#ifndef see_h
+#define see_h
+
+#include <stdint.h>
+
+/* Static exchange evaluation.
+ *
+ * Plays out the captures on one square without moving anything: the given side
+ * takes the piece there with its least valuable attacker, then the sides take
+ * turns recapturing with their least valuable attacker, each stopping once
+ * recapturing would lose. Sliders lined up behind a capturer join in as it
+ * leaves (x-rays). Pins and en passant are not considered.
+ *
+ * see() returns the material the side wins (centipawns, 0 when it cannot take
+ * anything there). see_ge() only answers whether that is at least a threshold,
+ * and stops as soon as the answer is known.
+ */
+
+int16_t see(uint8_t square, uint8_t side);
+uint8_t see_ge(uint8_t square, uint8_t side, int16_t threshold);
+
+#endif
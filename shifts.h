@@ -0,0 +1,112 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+#ifndef shifts_h
+#define shifts_h
+
+#include <stdint.h>
+
+/* Whole-board steps by a rank, a file or both.
+ *
+ * north and south move every square of a bitboard one rank up or down, east
+ * and west one file across, and squares that would leave the board (or wrap
+ * round to the other edge) are dropped. The diagonal and knight steps are
+ * made of these, so north(east(b)) is (b & ~FILE_H) << 9.
+ *
+ * On the host they are the plain 64-bit shifts. The AVR is an 8-bit core and
+ * avr-gcc turns every uint64_t shift into a libgcc call that moves all eight
+ * bytes one bit per round, so << 9 costs hundreds of cycles. But a rank is a
+ * byte: a rank step only moves bytes, which are register moves once inlined,
+ * and a file step is a one-bit shift inside each byte, where the bit that
+ * would wrap falls out of the byte with no file mask needed.
+ */
+
+#ifdef __AVR__
+
+#define SHIFT_INLINE static inline __attribute__((always_inline))
+
+// A bitboard as the bytes the AVR keeps it in, rank 1 first
+typedef union {
+    uint64_t bb;
+    uint8_t rank[8];
+} board_bytes;
+
+SHIFT_INLINE uint64_t north(uint64_t b) {
+    board_bytes u = { b };
+    board_bytes r;
+    r.rank[0] = 0;
+    r.rank[1] = u.rank[0];
+    r.rank[2] = u.rank[1];
+    r.rank[3] = u.rank[2];
+    r.rank[4] = u.rank[3];
+    r.rank[5] = u.rank[4];
+    r.rank[6] = u.rank[5];
+    r.rank[7] = u.rank[6];
+    return r.bb;
+}
+
+SHIFT_INLINE uint64_t south(uint64_t b) {
+    board_bytes u = { b };
+    board_bytes r;
+    r.rank[0] = u.rank[1];
+    r.rank[1] = u.rank[2];
+    r.rank[2] = u.rank[3];
+    r.rank[3] = u.rank[4];
+    r.rank[4] = u.rank[5];
+    r.rank[5] = u.rank[6];
+    r.rank[6] = u.rank[7];
+    r.rank[7] = 0;
+    return r.bb;
+}
+
+SHIFT_INLINE uint64_t east(uint64_t b) {
+    board_bytes u = { b };
+    u.rank[0] <<= 1;
+    u.rank[1] <<= 1;
+    u.rank[2] <<= 1;
+    u.rank[3] <<= 1;
+    u.rank[4] <<= 1;
+    u.rank[5] <<= 1;
+    u.rank[6] <<= 1;
+    u.rank[7] <<= 1;
+    return u.bb;
+}
+
+SHIFT_INLINE uint64_t west(uint64_t b) {
+    board_bytes u = { b };
+    u.rank[0] >>= 1;
+    u.rank[1] >>= 1;
+    u.rank[2] >>= 1;
+    u.rank[3] >>= 1;
+    u.rank[4] >>= 1;
+    u.rank[5] >>= 1;
+    u.rank[6] >>= 1;
+    u.rank[7] >>= 1;
+    return u.bb;
+}
+
+#else
+
+#define SHIFT_INLINE static inline
+
+SHIFT_INLINE uint64_t north(uint64_t b) {
+    return b << 8;
+}
+
+SHIFT_INLINE uint64_t south(uint64_t b) {
+    return b >> 8;
+}
+
+SHIFT_INLINE uint64_t east(uint64_t b) {
+    return (b << 1) & 0xFEFEFEFEFEFEFEFE;
+}
+
+SHIFT_INLINE uint64_t west(uint64_t b) {
+    return (b >> 1) & 0x7F7F7F7F7F7F7F7F;
+}
+
+#endif
+
+#endif
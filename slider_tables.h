@@ -0,0 +1,208 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+/* Flash-resident tables for the lookup slider kernel (see sliders.c).
+ *
+ * line_attacks[i][o]: squares attacked along a line of eight by a slider at
+ * position i, when the six inner squares of the line have occupancy o (the two
+ * end squares never block anything beyond themselves).
+ *
+ * diagonal_masks[sq][r] / anti_diagonal_masks[sq][r]: the square of rank r that
+ * lies on the a1-h8 / h1-a8 direction diagonal through sq, as a rank byte (zero
+ * if the diagonal does not reach that rank).
+ */
+
+#ifndef slider_tables_h
+#define slider_tables_h
+
+#include <stdint.h>
+#include "progmem.h"
+
+static const uint8_t line_attacks[8][64] PROGMEM = {
+    {
+        0xFE, 0x02, 0x06, 0x02, 0x0E, 0x02, 0x06, 0x02, 0x1E, 0x02, 0x06, 0x02, 0x0E, 0x02, 0x06, 0x02,
+        0x3E, 0x02, 0x06, 0x02, 0x0E, 0x02, 0x06, 0x02, 0x1E, 0x02, 0x06, 0x02, 0x0E, 0x02, 0x06, 0x02,
+        0x7E, 0x02, 0x06, 0x02, 0x0E, 0x02, 0x06, 0x02, 0x1E, 0x02, 0x06, 0x02, 0x0E, 0x02, 0x06, 0x02,
+        0x3E, 0x02, 0x06, 0x02, 0x0E, 0x02, 0x06, 0x02, 0x1E, 0x02, 0x06, 0x02, 0x0E, 0x02, 0x06, 0x02
+    },
+    {
+        0xFD, 0xFD, 0x05, 0x05, 0x0D, 0x0D, 0x05, 0x05, 0x1D, 0x1D, 0x05, 0x05, 0x0D, 0x0D, 0x05, 0x05,
+        0x3D, 0x3D, 0x05, 0x05, 0x0D, 0x0D, 0x05, 0x05, 0x1D, 0x1D, 0x05, 0x05, 0x0D, 0x0D, 0x05, 0x05,
+        0x7D, 0x7D, 0x05, 0x05, 0x0D, 0x0D, 0x05, 0x05, 0x1D, 0x1D, 0x05, 0x05, 0x0D, 0x0D, 0x05, 0x05,
+        0x3D, 0x3D, 0x05, 0x05, 0x0D, 0x0D, 0x05, 0x05, 0x1D, 0x1D, 0x05, 0x05, 0x0D, 0x0D, 0x05, 0x05
+    },
+    {
+        0xFB, 0xFA, 0xFB, 0xFA, 0x0B, 0x0A, 0x0B, 0x0A, 0x1B, 0x1A, 0x1B, 0x1A, 0x0B, 0x0A, 0x0B, 0x0A,
+        0x3B, 0x3A, 0x3B, 0x3A, 0x0B, 0x0A, 0x0B, 0x0A, 0x1B, 0x1A, 0x1B, 0x1A, 0x0B, 0x0A, 0x0B, 0x0A,
+        0x7B, 0x7A, 0x7B, 0x7A, 0x0B, 0x0A, 0x0B, 0x0A, 0x1B, 0x1A, 0x1B, 0x1A, 0x0B, 0x0A, 0x0B, 0x0A,
+        0x3B, 0x3A, 0x3B, 0x3A, 0x0B, 0x0A, 0x0B, 0x0A, 0x1B, 0x1A, 0x1B, 0x1A, 0x0B, 0x0A, 0x0B, 0x0A
+    },
+    {
+        0xF7, 0xF6, 0xF4, 0xF4, 0xF7, 0xF6, 0xF4, 0xF4, 0x17, 0x16, 0x14, 0x14, 0x17, 0x16, 0x14, 0x14,
+        0x37, 0x36, 0x34, 0x34, 0x37, 0x36, 0x34, 0x34, 0x17, 0x16, 0x14, 0x14, 0x17, 0x16, 0x14, 0x14,
+        0x77, 0x76, 0x74, 0x74, 0x77, 0x76, 0x74, 0x74, 0x17, 0x16, 0x14, 0x14, 0x17, 0x16, 0x14, 0x14,
+        0x37, 0x36, 0x34, 0x34, 0x37, 0x36, 0x34, 0x34, 0x17, 0x16, 0x14, 0x14, 0x17, 0x16, 0x14, 0x14
+    },
+    {
+        0xEF, 0xEE, 0xEC, 0xEC, 0xE8, 0xE8, 0xE8, 0xE8, 0xEF, 0xEE, 0xEC, 0xEC, 0xE8, 0xE8, 0xE8, 0xE8,
+        0x2F, 0x2E, 0x2C, 0x2C, 0x28, 0x28, 0x28, 0x28, 0x2F, 0x2E, 0x2C, 0x2C, 0x28, 0x28, 0x28, 0x28,
+        0x6F, 0x6E, 0x6C, 0x6C, 0x68, 0x68, 0x68, 0x68, 0x6F, 0x6E, 0x6C, 0x6C, 0x68, 0x68, 0x68, 0x68,
+        0x2F, 0x2E, 0x2C, 0x2C, 0x28, 0x28, 0x28, 0x28, 0x2F, 0x2E, 0x2C, 0x2C, 0x28, 0x28, 0x28, 0x28
+    },
+    {
+        0xDF, 0xDE, 0xDC, 0xDC, 0xD8, 0xD8, 0xD8, 0xD8, 0xD0, 0xD0, 0xD0, 0xD0, 0xD0, 0xD0, 0xD0, 0xD0,
+        0xDF, 0xDE, 0xDC, 0xDC, 0xD8, 0xD8, 0xD8, 0xD8, 0xD0, 0xD0, 0xD0, 0xD0, 0xD0, 0xD0, 0xD0, 0xD0,
+        0x5F, 0x5E, 0x5C, 0x5C, 0x58, 0x58, 0x58, 0x58, 0x50, 0x50, 0x50, 0x50, 0x50, 0x50, 0x50, 0x50,
+        0x5F, 0x5E, 0x5C, 0x5C, 0x58, 0x58, 0x58, 0x58, 0x50, 0x50, 0x50, 0x50, 0x50, 0x50, 0x50, 0x50
+    },
+    {
+        0xBF, 0xBE, 0xBC, 0xBC, 0xB8, 0xB8, 0xB8, 0xB8, 0xB0, 0xB0, 0xB0, 0xB0, 0xB0, 0xB0, 0xB0, 0xB0,
+        0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0,
+        0xBF, 0xBE, 0xBC, 0xBC, 0xB8, 0xB8, 0xB8, 0xB8, 0xB0, 0xB0, 0xB0, 0xB0, 0xB0, 0xB0, 0xB0, 0xB0,
+        0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0, 0xA0
+    },
+    {
+        0x7F, 0x7E, 0x7C, 0x7C, 0x78, 0x78, 0x78, 0x78, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70, 0x70,
+        0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60,
+        0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40,
+        0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40, 0x40
+    }
+};
+
+static const uint8_t diagonal_masks[64][8] PROGMEM = {
+    { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 },
+    { 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00 },
+    { 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00, 0x00 },
+    { 0x08, 0x10, 0x20, 0x40, 0x80, 0x00, 0x00, 0x00 },
+    { 0x10, 0x20, 0x40, 0x80, 0x00, 0x00, 0x00, 0x00 },
+    { 0x20, 0x40, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x40, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40 },
+    { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 },
+    { 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00 },
+    { 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00, 0x00 },
+    { 0x08, 0x10, 0x20, 0x40, 0x80, 0x00, 0x00, 0x00 },
+    { 0x10, 0x20, 0x40, 0x80, 0x00, 0x00, 0x00, 0x00 },
+    { 0x20, 0x40, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x40, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x00, 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20 },
+    { 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40 },
+    { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 },
+    { 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00 },
+    { 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00, 0x00 },
+    { 0x08, 0x10, 0x20, 0x40, 0x80, 0x00, 0x00, 0x00 },
+    { 0x10, 0x20, 0x40, 0x80, 0x00, 0x00, 0x00, 0x00 },
+    { 0x20, 0x40, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x00, 0x00, 0x00, 0x01, 0x02, 0x04, 0x08, 0x10 },
+    { 0x00, 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20 },
+    { 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40 },
+    { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 },
+    { 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00 },
+    { 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00, 0x00 },
+    { 0x08, 0x10, 0x20, 0x40, 0x80, 0x00, 0x00, 0x00 },
+    { 0x10, 0x20, 0x40, 0x80, 0x00, 0x00, 0x00, 0x00 },
+    { 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x04, 0x08 },
+    { 0x00, 0x00, 0x00, 0x01, 0x02, 0x04, 0x08, 0x10 },
+    { 0x00, 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20 },
+    { 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40 },
+    { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 },
+    { 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00 },
+    { 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00, 0x00 },
+    { 0x08, 0x10, 0x20, 0x40, 0x80, 0x00, 0x00, 0x00 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x04 },
+    { 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x04, 0x08 },
+    { 0x00, 0x00, 0x00, 0x01, 0x02, 0x04, 0x08, 0x10 },
+    { 0x00, 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20 },
+    { 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40 },
+    { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 },
+    { 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00 },
+    { 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00, 0x00 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x04 },
+    { 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x04, 0x08 },
+    { 0x00, 0x00, 0x00, 0x01, 0x02, 0x04, 0x08, 0x10 },
+    { 0x00, 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20 },
+    { 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40 },
+    { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 },
+    { 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x04 },
+    { 0x00, 0x00, 0x00, 0x00, 0x01, 0x02, 0x04, 0x08 },
+    { 0x00, 0x00, 0x00, 0x01, 0x02, 0x04, 0x08, 0x10 },
+    { 0x00, 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20 },
+    { 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40 },
+    { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 }
+};
+
+static const uint8_t anti_diagonal_masks[64][8] PROGMEM = {
+    { 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x02, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x04, 0x02, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x08, 0x04, 0x02, 0x01, 0x00, 0x00, 0x00, 0x00 },
+    { 0x10, 0x08, 0x04, 0x02, 0x01, 0x00, 0x00, 0x00 },
+    { 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00, 0x00 },
+    { 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00 },
+    { 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01 },
+    { 0x02, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x04, 0x02, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x08, 0x04, 0x02, 0x01, 0x00, 0x00, 0x00, 0x00 },
+    { 0x10, 0x08, 0x04, 0x02, 0x01, 0x00, 0x00, 0x00 },
+    { 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00, 0x00 },
+    { 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00 },
+    { 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01 },
+    { 0x00, 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02 },
+    { 0x04, 0x02, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00 },
+    { 0x08, 0x04, 0x02, 0x01, 0x00, 0x00, 0x00, 0x00 },
+    { 0x10, 0x08, 0x04, 0x02, 0x01, 0x00, 0x00, 0x00 },
+    { 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00, 0x00 },
+    { 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00 },
+    { 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01 },
+    { 0x00, 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02 },
+    { 0x00, 0x00, 0x80, 0x40, 0x20, 0x10, 0x08, 0x04 },
+    { 0x08, 0x04, 0x02, 0x01, 0x00, 0x00, 0x00, 0x00 },
+    { 0x10, 0x08, 0x04, 0x02, 0x01, 0x00, 0x00, 0x00 },
+    { 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00, 0x00 },
+    { 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00 },
+    { 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01 },
+    { 0x00, 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02 },
+    { 0x00, 0x00, 0x80, 0x40, 0x20, 0x10, 0x08, 0x04 },
+    { 0x00, 0x00, 0x00, 0x80, 0x40, 0x20, 0x10, 0x08 },
+    { 0x10, 0x08, 0x04, 0x02, 0x01, 0x00, 0x00, 0x00 },
+    { 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00, 0x00 },
+    { 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00 },
+    { 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01 },
+    { 0x00, 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02 },
+    { 0x00, 0x00, 0x80, 0x40, 0x20, 0x10, 0x08, 0x04 },
+    { 0x00, 0x00, 0x00, 0x80, 0x40, 0x20, 0x10, 0x08 },
+    { 0x00, 0x00, 0x00, 0x00, 0x80, 0x40, 0x20, 0x10 },
+    { 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00, 0x00 },
+    { 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00 },
+    { 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01 },
+    { 0x00, 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02 },
+    { 0x00, 0x00, 0x80, 0x40, 0x20, 0x10, 0x08, 0x04 },
+    { 0x00, 0x00, 0x00, 0x80, 0x40, 0x20, 0x10, 0x08 },
+    { 0x00, 0x00, 0x00, 0x00, 0x80, 0x40, 0x20, 0x10 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x40, 0x20 },
+    { 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00 },
+    { 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01 },
+    { 0x00, 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02 },
+    { 0x00, 0x00, 0x80, 0x40, 0x20, 0x10, 0x08, 0x04 },
+    { 0x00, 0x00, 0x00, 0x80, 0x40, 0x20, 0x10, 0x08 },
+    { 0x00, 0x00, 0x00, 0x00, 0x80, 0x40, 0x20, 0x10 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x40, 0x20 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x40 },
+    { 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01 },
+    { 0x00, 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02 },
+    { 0x00, 0x00, 0x80, 0x40, 0x20, 0x10, 0x08, 0x04 },
+    { 0x00, 0x00, 0x00, 0x80, 0x40, 0x20, 0x10, 0x08 },
+    { 0x00, 0x00, 0x00, 0x00, 0x80, 0x40, 0x20, 0x10 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x40, 0x20 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x40 },
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80 }
+};
+
+#endif
@@ -0,0 +1,372 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+#include <stdint.h>
+#include "chess_core.h"
+#include "sliders.h"
+#include "bits.h"
+#include "slider_tables.h"
+
+// Without an explicit choice the device uses flash lookups and the host dense tables
+#if !defined(SLIDERS_LOOP) && !defined(SLIDERS_FILL) && !defined(SLIDERS_TABLE) && !defined(SLIDERS_MAGIC)
+#ifdef __AVR__
+#define SLIDERS_TABLE
+#else
+#define SLIDERS_MAGIC
+#endif
+#endif
+
+#if defined(SLIDERS_MAGIC) && defined(__AVR__)
+#error "SLIDERS_MAGIC needs ~840 KB of tables and is host only"
+#endif
+
+/* Prepares the selected kernel (only the dense host tables need it) */
+void init_sliders() {
+#ifdef SLIDERS_MAGIC
+    static uint8_t ready = 0;
+    if (!ready) {
+        init_sliders_magic(cpu_has_pext());
+        ready = 1;
+    }
+#endif
+}
+
+/* Selected kernel */
+
+uint64_t rook_attacked(uint64_t rook_loc, uint64_t all_pieces) {
+#if defined(SLIDERS_LOOP)
+    return rook_attacked_loop(rook_loc, all_pieces);
+#elif defined(SLIDERS_MAGIC)
+    return rook_attacked_magic(rook_loc, all_pieces);
+#elif defined(SLIDERS_TABLE)
+    return rook_attacked_table(rook_loc, all_pieces);
+#else
+    return rook_attacked_fill(rook_loc, all_pieces);
+#endif
+}
+
+uint64_t bishop_attacked(uint64_t bishop_loc, uint64_t all_pieces) {
+#if defined(SLIDERS_LOOP)
+    return bishop_attacked_loop(bishop_loc, all_pieces);
+#elif defined(SLIDERS_MAGIC)
+    return bishop_attacked_magic(bishop_loc, all_pieces);
+#elif defined(SLIDERS_TABLE)
+    return bishop_attacked_table(bishop_loc, all_pieces);
+#else
+    return bishop_attacked_fill(bishop_loc, all_pieces);
+#endif
+}
+
+/* Set of squares attacked by a queen */
+uint64_t queen_attacked(uint64_t queen_loc, uint64_t all_pieces) {
+    return rook_attacked(queen_loc, all_pieces) | bishop_attacked(queen_loc, all_pieces);
+}
+
+/* Kogge-Stone occluded fills
+ *
+ * Each fill floods the generators (sliders) through the propagators (empty
+ * squares) in one direction with three doubling steps, so any ray length costs
+ * the same. Shifting the filled set one more step adds the blocker square.
+ * East/west moving directions mask the propagators so rays cannot wrap files.
+ */
+
+static uint64_t fill_north(uint64_t gen, uint64_t pro) {
+    gen |= pro & (gen << 8);
+    pro &= pro << 8;
+    gen |= pro & (gen << 16);
+    pro &= pro << 16;
+    gen |= pro & (gen << 32);
+    return gen;
+}
+
+static uint64_t fill_south(uint64_t gen, uint64_t pro) {
+    gen |= pro & (gen >> 8);
+    pro &= pro >> 8;
+    gen |= pro & (gen >> 16);
+    pro &= pro >> 16;
+    gen |= pro & (gen >> 32);
+    return gen;
+}
+
+static uint64_t fill_east(uint64_t gen, uint64_t pro) {
+    pro &= clear_file[FILE_A];
+    gen |= pro & (gen << 1);
+    pro &= pro << 1;
+    gen |= pro & (gen << 2);
+    pro &= pro << 2;
+    gen |= pro & (gen << 4);
+    return gen;
+}
+
+static uint64_t fill_west(uint64_t gen, uint64_t pro) {
+    pro &= clear_file[FILE_H];
+    gen |= pro & (gen >> 1);
+    pro &= pro >> 1;
+    gen |= pro & (gen >> 2);
+    pro &= pro >> 2;
+    gen |= pro & (gen >> 4);
+    return gen;
+}
+
+static uint64_t fill_north_east(uint64_t gen, uint64_t pro) {
+    pro &= clear_file[FILE_A];
+    gen |= pro & (gen << 9);
+    pro &= pro << 9;
+    gen |= pro & (gen << 18);
+    pro &= pro << 18;
+    gen |= pro & (gen << 36);
+    return gen;
+}
+
+static uint64_t fill_north_west(uint64_t gen, uint64_t pro) {
+    pro &= clear_file[FILE_H];
+    gen |= pro & (gen << 7);
+    pro &= pro << 7;
+    gen |= pro & (gen << 14);
+    pro &= pro << 14;
+    gen |= pro & (gen << 28);
+    return gen;
+}
+
+static uint64_t fill_south_east(uint64_t gen, uint64_t pro) {
+    pro &= clear_file[FILE_A];
+    gen |= pro & (gen >> 7);
+    pro &= pro >> 7;
+    gen |= pro & (gen >> 14);
+    pro &= pro >> 14;
+    gen |= pro & (gen >> 28);
+    return gen;
+}
+
+static uint64_t fill_south_west(uint64_t gen, uint64_t pro) {
+    pro &= clear_file[FILE_H];
+    gen |= pro & (gen >> 9);
+    pro &= pro >> 9;
+    gen |= pro & (gen >> 18);
+    pro &= pro >> 18;
+    gen |= pro & (gen >> 36);
+    return gen;
+}
+
+/* Set of squares attacked by a set of rooks, all rooks at once */
+uint64_t rook_attacked_fill(uint64_t rook_loc, uint64_t all_pieces) {
+
+    uint64_t empty = ~all_pieces;
+
+    return (fill_north(rook_loc, empty) << 8) |
+           (fill_south(rook_loc, empty) >> 8) |
+           ((fill_east(rook_loc, empty) << 1) & clear_file[FILE_A]) |
+           ((fill_west(rook_loc, empty) >> 1) & clear_file[FILE_H]);
+}
+
+/* Set of squares attacked by a set of bishops, all bishops at once */
+uint64_t bishop_attacked_fill(uint64_t bishop_loc, uint64_t all_pieces) {
+
+    uint64_t empty = ~all_pieces;
+
+    return ((fill_north_east(bishop_loc, empty) << 9) & clear_file[FILE_A]) |
+           ((fill_north_west(bishop_loc, empty) << 7) & clear_file[FILE_H]) |
+           ((fill_south_east(bishop_loc, empty) >> 7) & clear_file[FILE_A]) |
+           ((fill_south_west(bishop_loc, empty) >> 9) & clear_file[FILE_H]);
+}
+
+/* Flash table lookups
+ *
+ * A bitboard is eight rank bytes, so on an 8-bit core a rank is free to read
+ * and its inner six bits index line_attacks directly. Files and diagonals are
+ * gathered into the same eight-square line form one byte per rank, looked up
+ * in the same table, then scattered back. This costs a fixed handful of byte
+ * operations per slider and 1.5 KB of flash.
+ */
+
+typedef union {
+    uint64_t bb;
+    uint8_t rank[BOARD_SIZE];
+} rank_bytes;
+
+static const uint8_t bit_mask[BOARD_SIZE] = { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 };
+
+/* Adds the rank and file attacks of a rook on file f, rank r */
+static void rook_lookup(const rank_bytes* occ, uint8_t f, uint8_t r, rank_bytes* att) {
+
+    uint8_t file_bit = bit_mask[f];
+
+    // Rank
+    att->rank[r] |= pgm_read_byte(&line_attacks[f][(occ->rank[r] >> 1) & 63]);
+
+    // File
+    uint8_t line = 0;
+    for (uint8_t k = 1; k < BOARD_SIZE - 1; k++) {
+        if (occ->rank[k] & file_bit) line |= bit_mask[k];
+    }
+    uint8_t attacks = pgm_read_byte(&line_attacks[r][line >> 1]);
+    for (uint8_t k = 0; k < BOARD_SIZE; k++) {
+        if (attacks & bit_mask[k]) att->rank[k] |= file_bit;
+    }
+}
+
+/* Adds the diagonal and anti-diagonal attacks of a bishop on square sq, rank r */
+static void bishop_lookup(const rank_bytes* occ, uint8_t sq, uint8_t r, rank_bytes* att) {
+
+    uint8_t diag_line = 0;
+    uint8_t anti_line = 0;
+
+    for (uint8_t k = 1; k < BOARD_SIZE - 1; k++) {
+        if (occ->rank[k] & pgm_read_byte(&diagonal_masks[sq][k])) diag_line |= bit_mask[k];
+        if (occ->rank[k] & pgm_read_byte(&anti_diagonal_masks[sq][k])) anti_line |= bit_mask[k];
+    }
+
+    uint8_t diag = pgm_read_byte(&line_attacks[r][diag_line >> 1]);
+    uint8_t anti = pgm_read_byte(&line_attacks[r][anti_line >> 1]);
+
+    for (uint8_t k = 0; k < BOARD_SIZE; k++) {
+        if (diag & bit_mask[k]) att->rank[k] |= pgm_read_byte(&diagonal_masks[sq][k]);
+        if (anti & bit_mask[k]) att->rank[k] |= pgm_read_byte(&anti_diagonal_masks[sq][k]);
+    }
+}
+
+/* Set of squares attacked by a set of rooks, one table lookup per rook */
+uint64_t rook_attacked_table(uint64_t rook_loc, uint64_t all_pieces) {
+
+    rank_bytes occ = { all_pieces };
+    rank_bytes att = { 0 };
+
+    for_each_bit(sq, rook_loc) {
+        rook_lookup(&occ, sq % BOARD_SIZE, sq / BOARD_SIZE, &att);
+    }
+
+    return att.bb;
+}
+
+/* Set of squares attacked by a set of bishops, one table lookup per bishop */
+uint64_t bishop_attacked_table(uint64_t bishop_loc, uint64_t all_pieces) {
+
+    rank_bytes occ = { all_pieces };
+    rank_bytes att = { 0 };
+
+    for_each_bit(sq, bishop_loc) {
+        bishop_lookup(&occ, sq, sq / BOARD_SIZE, &att);
+    }
+
+    return att.bb;
+}
+
+/* Set of squares attacked by a set of rooks, walking each ray square by square */
+uint64_t rook_attacked_loop(uint64_t rook_loc, uint64_t all_pieces) {
+
+    // Rays are horizontal and vertical
+    // => We can use masks!
+
+    // Memory constraints => we can't use lookup tables here.
+    // Would require 8 * 256 * 8 * 2 = 33kB > 8kB RAM for all combinations.
+
+    // We need to stop the ray as soon as it hits the first enemy piece
+
+    uint64_t valid = 0;
+
+    for_each_bit(rf, rook_loc) {
+
+        // Build upward ray
+        int8_t p = rf;
+        while (p + 8 < BOARD_SIZE * BOARD_SIZE) {
+            p += 8;
+            valid |= piece[p];
+            if (piece[p] & all_pieces) break;
+        }
+
+        // Build downward ray
+        p = rf;
+        while (p - 8 >= 0) {
+            p -= 8;
+            valid |= piece[p];
+            if (piece[p] & all_pieces) break;
+        }
+
+        uint8_t left_edge = (rf / BOARD_SIZE) * BOARD_SIZE;
+        uint8_t right_edge = left_edge + BOARD_SIZE - 1;
+
+        // Build right ray
+        p = rf;
+        while ((p + 1) <= right_edge) {
+            p++;
+            valid |= piece[p];
+            if (piece[p] & all_pieces) break;
+        }
+
+        // Build left ray
+        p = rf;
+        while ((p - 1) >= left_edge) {
+            p--;
+            valid |= piece[p];
+            if (piece[p] & all_pieces) break;
+        }
+    }    
+
+    return valid;
+}
+
+/* Set of squares attacked by a set of bishops, walking each ray square by square */
+uint64_t bishop_attacked_loop(uint64_t bishop_loc, uint64_t all_pieces) {
+
+    uint64_t valid = 0;
+
+    for_each_bit(rf, bishop_loc) {
+
+        uint8_t x, y;
+        rf_to_dp(rf, &x, &y);
+
+        uint8_t x_tmp = x;
+        uint8_t y_tmp = y;
+        uint8_t p;
+
+        // TR
+        while(x_tmp + 1 < BOARD_SIZE && y_tmp - 1 >= 0) {
+            x_tmp++;
+            y_tmp--;
+            p = dp_to_rf(x_tmp, y_tmp);
+            valid |= piece[p];
+            if (piece[p] & all_pieces) break;
+        }
+
+        x_tmp = x;
+        y_tmp = y;
+
+        // TL
+        while(x_tmp - 1 >= 0 && y_tmp - 1 >= 0) {
+            x_tmp--;
+            y_tmp--;
+            p = dp_to_rf(x_tmp, y_tmp);
+            valid |= piece[p];
+            if (piece[p] & all_pieces) break;
+        }
+
+        x_tmp = x;
+        y_tmp = y;
+
+        // BL
+        while(x_tmp - 1 >= 0 && y_tmp + 1 < BOARD_SIZE) {
+            x_tmp--;
+            y_tmp++;
+            p = dp_to_rf(x_tmp, y_tmp);
+            valid |= piece[p];
+            if (piece[p] & all_pieces) break;
+        }
+
+        x_tmp = x;
+        y_tmp = y;
+
+        // BR
+        while(x_tmp + 1 < BOARD_SIZE && y_tmp + 1 < BOARD_SIZE) {
+            x_tmp++;
+            y_tmp++;
+            p = dp_to_rf(x_tmp, y_tmp);
+            valid |= piece[p];
+            if (piece[p] & all_pieces) break;
+        }
+    }
+
+    return valid;
+
+}
@@ -0,0 +1,56 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+#ifndef sliders_h
+#define sliders_h
+
+#include <stdint.h>
+
+/* Slider attack sets (rook, bishop and queen).
+ *
+ * Every function takes a SET of sliders and returns the union of the squares
+ * they attack, up to and including the first blocker in each direction.
+ *
+ * The kernel behind rook_attacked/bishop_attacked is chosen at build time:
+ *   SLIDERS_TABLE  flash-resident line tables, one lookup per slider (device default)
+ *   SLIDERS_MAGIC  dense PEXT/magic tables picked by CPUID (host default, host only)
+ *   SLIDERS_FILL   Kogge-Stone occluded fill, no tables, no data-dependent loops
+ *   SLIDERS_LOOP   original per-square ray walk
+ * Every kernel available on the target is built so they can be compared.
+ * init_sliders() must run before the first query (init_board does this).
+ */
+
+void init_sliders();
+
+uint64_t rook_attacked(uint64_t rook_loc, uint64_t all_pieces);
+uint64_t bishop_attacked(uint64_t bishop_loc, uint64_t all_pieces);
+uint64_t queen_attacked(uint64_t queen_loc, uint64_t all_pieces);
+
+/* Kogge-Stone occluded fill kernel */
+
+uint64_t rook_attacked_fill(uint64_t rook_loc, uint64_t all_pieces);
+uint64_t bishop_attacked_fill(uint64_t bishop_loc, uint64_t all_pieces);
+
+/* Flash table kernel */
+
+uint64_t rook_attacked_table(uint64_t rook_loc, uint64_t all_pieces);
+uint64_t bishop_attacked_table(uint64_t bishop_loc, uint64_t all_pieces);
+
+/* Dense table kernel (host only) */
+
+#ifndef __AVR__
+extern uint8_t slider_pext;
+uint8_t cpu_has_pext();
+void init_sliders_magic(uint8_t pext);
+uint64_t rook_attacked_magic(uint64_t rook_loc, uint64_t all_pieces);
+uint64_t bishop_attacked_magic(uint64_t bishop_loc, uint64_t all_pieces);
+#endif
+
+/* Ray walking kernel */
+
+uint64_t rook_attacked_loop(uint64_t rook_loc, uint64_t all_pieces);
+uint64_t bishop_attacked_loop(uint64_t bishop_loc, uint64_t all_pieces);
+
+#endif
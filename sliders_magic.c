@@ -0,0 +1,187 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+#include <stdint.h>
+#include "chess_core.h"
+#include "sliders.h"
+#include "bits.h"
+
+/* Dense lookup kernel for the host build.
+ *
+ * Every square keeps the mask of squares whose occupancy can block it and a
+ * slice of a shared attack table with one entry per subset of that mask. The
+ * subset is turned into an index with PEXT on CPUs that have BMI2, or with a
+ * fancy magic multiply (per-square shift) elsewhere. The choice is made once at
+ * startup from CPUID (see init_sliders). Tables are ~840 KB, so this is host only.
+ */
+
+#ifndef __AVR__
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_PEXT 1
+#endif
+
+typedef struct {
+    uint64_t mask;
+    uint64_t magic;
+    uint64_t* attacks;
+    uint8_t shift;
+} magic_entry;
+
+static magic_entry rook_magics[BOARD_SIZE * BOARD_SIZE];
+static magic_entry bishop_magics[BOARD_SIZE * BOARD_SIZE];
+
+static uint64_t rook_table[102400];
+static uint64_t bishop_table[5248];
+
+// Non-zero when the tables are laid out for PEXT indexing
+uint8_t slider_pext = 0;
+
+/* Squares that can block a slider on sq, excluding the board edge in each direction */
+static uint64_t relevant_mask(uint8_t sq, uint8_t rook) {
+    uint64_t edges = ((mask_rank[RANK_1] | mask_rank[RANK_8]) & ~mask_rank[sq / BOARD_SIZE]) |
+                     ((mask_file[FILE_A] | mask_file[FILE_H]) & ~mask_file[sq % BOARD_SIZE]);
+    uint64_t loc = (uint64_t) 1 << sq;
+    uint64_t attacks = rook ? rook_attacked_fill(loc, 0) : bishop_attacked_fill(loc, 0);
+    return attacks & ~edges;
+}
+
+static uint64_t magic_random_state = 0x2545F4914F6CDD1DULL;
+
+/* Sparse random candidates find magics much faster */
+static uint64_t sparse_random() {
+    uint64_t r = ~(uint64_t) 0;
+    for (uint8_t i = 0; i < 3; i++) {
+        magic_random_state ^= magic_random_state << 13;
+        magic_random_state ^= magic_random_state >> 7;
+        magic_random_state ^= magic_random_state << 17;
+        r &= magic_random_state;
+    }
+    return r;
+}
+
+/* Fills one square's slice of the table, returning the slot after it */
+static uint64_t* init_square(magic_entry* m, uint8_t sq, uint8_t rook, uint64_t* table) {
+
+    static uint64_t occupancy[4096];
+    static uint64_t reference[4096];
+    static uint32_t epoch[4096];
+    static uint32_t attempt = 0;
+
+    uint64_t loc = (uint64_t) 1 << sq;
+    uint32_t size = 0;
+
+    m->mask = relevant_mask(sq, rook);
+    m->shift = 64 - popcount(m->mask);
+    m->attacks = table;
+
+    // Carry-rippler walk over every subset of the mask, in PEXT index order
+    uint64_t subset = 0;
+    do {
+        occupancy[size] = subset;
+        reference[size] = rook ? rook_attacked_fill(loc, subset) : bishop_attacked_fill(loc, subset);
+        size++;
+        subset = (subset - m->mask) & m->mask;
+    } while (subset);
+
+    if (slider_pext) {
+        for (uint32_t i = 0; i < size; i++) table[i] = reference[i];
+        return table + size;
+    }
+
+    // Search for a magic mapping every subset to a slot without destructive collisions
+    for (;;) {
+        uint64_t magic = sparse_random();
+        if (popcount((m->mask * magic) >> 56) < 6) continue;
+
+        attempt++;
+        uint32_t i;
+        for (i = 0; i < size; i++) {
+            uint32_t idx = (uint32_t) ((occupancy[i] * magic) >> m->shift);
+            if (epoch[idx] < attempt) {
+                epoch[idx] = attempt;
+                table[idx] = reference[i];
+            } else if (table[idx] != reference[i]) {
+                break;
+            }
+        }
+        if (i == size) {
+            m->magic = magic;
+            return table + size;
+        }
+    }
+}
+
+static void fill_tables() {
+    uint64_t* next = rook_table;
+    for (uint8_t sq = 0; sq < BOARD_SIZE * BOARD_SIZE; sq++) {
+        next = init_square(&rook_magics[sq], sq, 1, next);
+    }
+    next = bishop_table;
+    for (uint8_t sq = 0; sq < BOARD_SIZE * BOARD_SIZE; sq++) {
+        next = init_square(&bishop_magics[sq], sq, 0, next);
+    }
+}
+
+/* Lays the tables out for PEXT (if asked and supported) or for magic multiplies */
+void init_sliders_magic(uint8_t pext) {
+#ifdef HAVE_PEXT
+    slider_pext = pext;
+#else
+    slider_pext = 0;
+    (void) pext;
+#endif
+    fill_tables();
+}
+
+/* Does this CPU have BMI2 (and so a fast PEXT)? */
+uint8_t cpu_has_pext() {
+#ifdef HAVE_PEXT
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("bmi2") != 0;
+#else
+    return 0;
+#endif
+}
+
+#ifdef HAVE_PEXT
+__attribute__((target("bmi2")))
+static uint64_t attacked_pext(const magic_entry* m, uint64_t loc, uint64_t all_pieces) {
+    uint64_t valid = 0;
+    for_each_bit(sq, loc) {
+        const magic_entry* e = &m[sq];
+        valid |= e->attacks[_pext_u64(all_pieces, e->mask)];
+    }
+    return valid;
+}
+#endif
+
+static uint64_t attacked_magic(const magic_entry* m, uint64_t loc, uint64_t all_pieces) {
+    uint64_t valid = 0;
+    for_each_bit(sq, loc) {
+        const magic_entry* e = &m[sq];
+        valid |= e->attacks[((all_pieces & e->mask) * e->magic) >> e->shift];
+    }
+    return valid;
+}
+
+/* Set of squares attacked by a set of rooks, one table lookup per rook */
+uint64_t rook_attacked_magic(uint64_t rook_loc, uint64_t all_pieces) {
+#ifdef HAVE_PEXT
+    if (slider_pext) return attacked_pext(rook_magics, rook_loc, all_pieces);
+#endif
+    return attacked_magic(rook_magics, rook_loc, all_pieces);
+}
+
+/* Set of squares attacked by a set of bishops, one table lookup per bishop */
+uint64_t bishop_attacked_magic(uint64_t bishop_loc, uint64_t all_pieces) {
+#ifdef HAVE_PEXT
+    if (slider_pext) return attacked_pext(bishop_magics, bishop_loc, all_pieces);
+#endif
+    return attacked_magic(bishop_magics, bishop_loc, all_pieces);
+}
+
+#endif
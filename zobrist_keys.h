@@ -0,0 +1,257 @@
+/*  Author: Dulhan Jayalath
+ * Licence: This work is licensed under the Creative Commons Attribution License.
+ *           View this license at http://creativecommons.org/about/licenses/
+ */
+
+/* Zobrist keys for position hashing (see hash_key in chess_core.c), from a
+ * fixed-seed xorshift64* stream so keys are the same on every build.
+ *
+ * zobrist_pieces[type - W_PAWN][sq]: a piece of that type on rank-file index sq.
+ * zobrist_castle[castle_flags]: the castling rights, each entry the XOR of one
+ * key per right held.
+ * zobrist_ep_file[file]: an en passant capture is possible on that file.
+ * zobrist_side: black to move.
+ *
+ * About 6 KB, in flash on the device (read with pgm_read_bitboard).
+ */
+
+#ifndef zobrist_keys_h
+#define zobrist_keys_h
+
+#include <stdint.h>
+#include "progmem.h"
+
+static const uint64_t zobrist_pieces[B_KING][BOARD_SIZE * BOARD_SIZE] PROGMEM = {
+    {
+        0xAD5DB60B4C5D45D4, 0xBEDAF65D8707906E, 0x0A1FE02D6C6DD3D0, 0x9706F44D6F0B43B4,
+        0xFDF3C3D8A31FA376, 0x481E64CC0CD21571, 0x20B83DCC23713DFA, 0x785134315B1EDC82,
+        0x7AA278FEECA0B1E4, 0x570A4617426E8317, 0xD38DEAB3E2C7E7F7, 0xE8E9C73B7A573657,
+        0x579B01B746B1A2B0, 0x1166CA4DAE545252, 0x1BE7F175C089F047, 0x99505F624166747C,
+        0xEB6D89BB9B6ED8AA, 0xF5D675491F586D7B, 0xBA59E109CEFE84D9, 0x681AB9D75AEBF6EA,
+        0x62D969A4129A9F24, 0x74961E93526F20E2, 0x0E87D5A8ECA0D509, 0xEC286AFA765DE909,
+        0xB803B3E81516FA8E, 0x1BF8FFEB12F0477C, 0xB42A39CC02ED848D, 0x03033E63EC499479,
+        0xFEB129153FDA9651, 0x44B38F52C2CB246F, 0x77052597241FD422, 0x65CC6C2D4F22FEFF,
+        0x984CADF4365C51E9, 0xB074A29BB4578F85, 0x6950716A7A91A86C, 0x19D27EAFD9479350,
+        0x478FFD1134CB1FCD, 0x3F3A906D1009109E, 0x3010D34DEB04D425, 0xD522D8950B13B8FB,
+        0x6AB054700463CA78, 0x594069F3EFC624A4, 0x2EE1515D21C28506, 0x39CAA9523762F621,
+        0x90D49BA9515D124C, 0xE348221936BB02B5, 0x3893C47348227758, 0x0CB732BA5A3C9445,
+        0x4B09F5AA7B398602, 0x1141CC90E12B7825, 0xB77D5DE085F26FC8, 0xA04F22B1AD1B59C1,
+        0xE10FC532942F357F, 0xCED9D7FF335AB2BB, 0xFC29389453000277, 0x70CCB66661F1F473,
+        0x6A53C92E60D0FA2A, 0xD0D58D5288553C35, 0x46DD71935E14B7F2, 0x7BBE2CDFF5FA016D,
+        0x1AE498CFCC9305B9, 0xCF43FF52AC63EF37, 0x8F854403D20C1461, 0x397735B98A5E2709
+    },
+    {
+        0xD6C7F980555016D3, 0x572E9FC98C47F6C7, 0x1211541657483006, 0xFED6C013B16E1AC0,
+        0xAC55480FC0909F7E, 0x572A46828C332A48, 0xEEB15BDDB5B70BC5, 0x3F8A118F3D4CCC2B,
+        0xC902B8F9F728FDAB, 0xF4D5B4CDF7FD83ED, 0x1C67C6251F0EC2DE, 0xE1DCD8625803C545,
+        0x5F39F5D4DFAF37FE, 0xAFEA07718BA8FB79, 0x1E0675D4A3AF17BD, 0x42E7BDA2D6F5377B,
+        0x7FDA235CE8ED7C8C, 0xBC2EF79915882BFA, 0xE08CE14975A8D23D, 0x3BA40B35D2B35BA3,
+        0x15DBC8E4AEB8119B, 0xC3705BF3050E683B, 0x5649C9E9E0986949, 0x4EEE9A37894A6F1D,
+        0x5CB284E2B6AC608F, 0xFCC696099289073A, 0x0C1FD69071E43139, 0x420CDBD1A805480E,
+        0xDE6884E9AE84C702, 0xA8903E103EC1CF66, 0x51D7DCA5D19842DD, 0xD1F9EBBEE9AA67C3,
+        0xA4A73283196E3668, 0x57191D6AB5A0A7F8, 0x461159C13C4D935B, 0x229BC804D9DE4B15,
+        0x72A8D27093CC8C4B, 0x2916F6ADC55C1469, 0x4B11D7DB8CE1583E, 0x7960836FC11F29C8,
+        0x6137493324C58F68, 0xA5DF5439C3A5989F, 0x23C2066BEBA9F1F7, 0x10E1E68BBA8F9DA5,
+        0x8691786EFE019D33, 0x8A92D09A32462E69, 0x0285D107E78ACC6F, 0xC74AA14F847D42CB,
+        0xB74E2C1232D81925, 0x6FBD16630E53DBD9, 0x4A1D746BB7982D44, 0xACFB3387988492B6,
+        0x64D6A44BF80D3277, 0x97A73F720FA740A5, 0x098005F3D408A57A, 0x12651FC31E44A882,
+        0x1BC6CE6504EE46CB, 0xAE7E4015C45C31BB, 0xF12FA1C18CB439E0, 0x5E41AC476F931998,
+        0x9F805D1B6D6DF690, 0x860B5EB0C2454CAE, 0x5D13EE432752D825, 0x5EA88E7A598BFF82
+    },
+    {
+        0x87CA92BE5763E30A, 0x04076D17F94EB038, 0x527C3209D3AE020C, 0x0629E166B4935C65,
+        0xE020918EA519C3FA, 0xE075C81C8B0254D8, 0xA4A75E2511491071, 0x74A78C491EB52602,
+        0xDD04B147148C91D1, 0xC369B36ACC1C74EE, 0x897D2DD6B0049A11, 0x06C5EE9AFC42B4AD,
+        0x872D9F640C2DFA59, 0x44C48319BB8C1B05, 0x3716C481D2C80608, 0xF173B6A69AFBB029,
+        0x31B74B5E139314F3, 0x859C6A51968BFDB7, 0x63B82D198AA88589, 0x6FEE95DB375C9156,
+        0x9B324DE7F15D0D8B, 0x3755D21E91509804, 0x61F015CB44E38685, 0x3888519366177711,
+        0xB3FCF467412D1A76, 0x37813D302349827F, 0xC0F185FA1D37E871, 0x48C9E3A68230D42F,
+        0xEC2EC3E8190926EE, 0xF2E2879AC097653B, 0x076C290BD20B634A, 0xC2653727A57FE93B,
+        0xE1E221522D666461, 0x399BE906E2E6E8B0, 0x10CD2F709690491C, 0x52DE906E711FAD06,
+        0xE3C73FBDC7A39143, 0x05176AB0AA536CA0, 0x32CAB841BC2A998A, 0x02F89EC0526EB1E5,
+        0x389E23E533FF18A4, 0x9DD3AB723E373278, 0xC37AD6DA67CA439C, 0x695D165EA187625E,
+        0x79FD7B9695E042E0, 0x349F4ECB7EC8507D, 0x82CF7242C8431117, 0x40265C7D5545EC5C,
+        0x09E9082192B8FADA, 0xC29B1278E2054D67, 0xB2F9F8B5F1C5CF37, 0x764782C4E6A4FD20,
+        0xF75EF9B49426F003, 0x1E566A7EFECE2EE0, 0xC7FB497FC30A6784, 0x8007E30C22542C6C,
+        0xAB2CED5FA3542192, 0x40E588252B1823C7, 0x919F92BA3DF16D08, 0x6FD879EAA35DE755,
+        0x6D5D96C5CC89706A, 0x6D426DBF69C26009, 0xFC2DDFC09E1124AF, 0x45A64B9256AD71FE
+    },
+    {
+        0xCC82E8FC64847807, 0xFDE9BC6E3DA7BC7F, 0x8FDAE79D0D3D1826, 0x5F29BBDFC243539E,
+        0x400003103BBCE787, 0x51506611CB77A6B9, 0xDCC08A4381B5B04B, 0x7F6F9E8B4A7EF5C2,
+        0x7D0032E467053ACB, 0xCA36983735803509, 0x4FD524D92A4210FF, 0x84959AF3C956A4CD,
+        0x399EB1DF00CBF7C5, 0x4502C5E2BBA8008F, 0xA8B8FE84D4BD3ECC, 0xA709D2480FE2D3CC,
+        0x93C5733A82FD4513, 0x1AF451BCFB558613, 0xEBFC5FEB5C311091, 0x5310F0EE6D58336B,
+        0x3543E295A621F9B8, 0xAE71D0A37287C0C6, 0x76B2B25DA01A2ACF, 0xA20010F053DA4BDA,
+        0x1570E519141F14E4, 0xB0269462C4D7FBC8, 0xA1B3BE0063264A9F, 0x98FBA0717E44805A,
+        0xCE077E0CBF1B5634, 0x6D72F25B821239A2, 0x57A41696E2A9FA09, 0x9C2543FDC67E1864,
+        0xDC67639B0E17BF3C, 0xC308F72330411E3D, 0x88206EEC7A80EF33, 0x6B4481E526CE3CA0,
+        0xAA1B48AEA6B23BBA, 0xD0CF93EE3281B7A9, 0xBCA2EDE0D126AD25, 0x32A811E4D7571B71,
+        0x4352252A2CAD8060, 0xAC311AB687C93DD5, 0x7136FF179EE91CE8, 0x3D93F5C4DBBD3210,
+        0xFDA6F04123BB61E6, 0x34762DABE28D3028, 0x19D57E143F07546E, 0xEEBBF0A82B5BF9B2,
+        0x92E0A606004CDB73, 0xBFBEE82F593AFA29, 0xA58F407F4ED63658, 0x7D1B7C953ED13432,
+        0xDE662386370E6668, 0x5A6FD5C4BCBB642E, 0x7D3DF1CF326FA5D5, 0xBBE438CEDFE064E9,
+        0xCAA08BDFAA7E3DE8, 0x4595416644A838AA, 0x6E6424851DE0CC2C, 0x6EBB9BC61DD49128,
+        0x13A25F8B220FB912, 0x13367E5A067FC9B0, 0x0C57E5A11F384540, 0x9BF287E8F37237C2
+    },
+    {
+        0xE27D7697BC02101B, 0x8B01EA84EFD364F6, 0x26DF2F753C25F4F9, 0x618A38AFDE8BA407,
+        0x27F82AD587AB9C62, 0xCCBE9F1BD5896230, 0x62C26E92A199819B, 0xEA0900B0DD59EA24,
+        0xC08F4803B0DCF432, 0x996833DB304F8409, 0x48F4DCED60ED022D, 0xF091FA220536BBA4,
+        0xDA63C0FCCB0F7323, 0x7B4A47A4DCC40901, 0xF4B739C1030AA126, 0xC0725BC5E02D50D3,
+        0x1B7121D4BEC7B6A2, 0x6FAB0F4AA55FF6EA, 0x4B6764971F3AC4F1, 0x344A8ADD89162238,
+        0xC7C21F01BF9668E1, 0x7C35C67335E5FEB7, 0xAE61BF37F4EA6948, 0xA28E91CE7C269B28,
+        0xA8F834139286D855, 0x3E4A328B9775C326, 0xC4874F2A2FADC806, 0xF77292CE38005C9E,
+        0x28EE605593889A2B, 0x89463389D0DEF8B8, 0x13AA5B6F59B47DC5, 0x46E65C67C15C0693,
+        0x4A6272DAF49689E4, 0xD65F14C07FFC389D, 0x5D093F382A648954, 0x63F49F6E28471B8A,
+        0xDF2E744B5F83C19F, 0x64EB0B3F57AA51CA, 0xB206BAA12B08B1BB, 0xC80D088B70E908AB,
+        0xED84D2E8C1BDC92A, 0x6CF5F98C0AF7666F, 0x0705FB2364A72FB9, 0x2D1632FD8B7FC7A0,
+        0x20187900DBBE0DBD, 0xA7053E7B4BFCF357, 0x19152A6BEAD8EF9D, 0xC98E15E6BF5CAC92,
+        0xD510112B8D13632B, 0xBD670D35658B348E, 0x5971D381A97E480A, 0x3A2A386C69D04DD8,
+        0x411D731E9E6AE5D2, 0x4BC5159361AF6232, 0x48518EC4498A8A49, 0xC23D1BEF7F16B3A5,
+        0x3E8E77EEFE845C39, 0x9BF50856FD40570D, 0xDFBFFE3E14E27261, 0x8C1FA9D5EA6B4678,
+        0xA3730515A5751DFC, 0xD5AD3009DBEEEB9D, 0xC687EFDF7CE9C8DB, 0xDFEECEC57CCBC94E
+    },
+    {
+        0x71F8880F9A619DC6, 0x826A45ECE6E2CB23, 0x468FC64CAD673146, 0xE3A45E853B0C8089,
+        0x693CC3F5FC08E294, 0x3CC74FF61BE8AF6E, 0xF4E35EE067C7990F, 0xFAE0787EBF6135B2,
+        0xEA97F5245C88D6F6, 0x937560EEA42027AC, 0x7EF8845D442D37CA, 0x5114D4FE61DB6C01,
+        0xAF85DEB3E95FFE73, 0xA8D6DBD99D848148, 0x7034C88122A5793D, 0x94AA1FD1763563E9,
+        0xE85808DFDB2BBBA7, 0x329D9626ABA6BDC3, 0x548BF679DDF2E2C0, 0xF50EAED393D1250D,
+        0xBFF34CD135E3C20B, 0x277C80F33399D619, 0xF22DFFADD24E492A, 0xEAC88DBB2183CFE9,
+        0xE9D39C4B3FE3C53F, 0x52FC06A3251B3BA5, 0x5B49853B6DFEC9C4, 0x57FED40EC63B0078,
+        0x47CB1EF4FECC4545, 0xDF0A2D9010E38968, 0x42B4BFFA96E4ED01, 0x6F3371FCCA48470F,
+        0x7D4945CD7B0B2504, 0x215A7B754C7A6E73, 0xACCB7268993B6191, 0x5B65B30BE7CE73D2,
+        0x1DA00E7CB35BAA02, 0xE954E02ED9C54BAA, 0x708F6EB023EAA8D4, 0x9B29B207D157EDF2,
+        0x055B322A0E830CA0, 0x48BC96FE32036E70, 0x41BBD67AE57719DC, 0xF35BE87E513BE1EF,
+        0xAD64512C8FB74078, 0x8F14538B2A72AE57, 0x60DBB04234247668, 0x41A99C8647E31D2B,
+        0x0DA3FAD96E59D70F, 0x838340026062AF3B, 0x20E23F53693DF264, 0xF7AFC4C5A0D97CC2,
+        0xE123E16B16842948, 0x701EFA30C1516B12, 0xB4F31324EA844203, 0x2985A7F711FE3D2A,
+        0x5D0CD18365781F29, 0x68D961D386DA142A, 0x96AD037E08DD4E83, 0x3344CBE7C66D78B3,
+        0x9CE7DB1AA1D9191B, 0x0789D7D472A1D741, 0x97080AFA0D86E78B, 0x8BBE5300C301A35E
+    },
+    {
+        0xB1273C5323B1468E, 0x7632F448102CBC92, 0xE671ABABD8EF6609, 0x2C429A7B42B25DA8,
+        0x20BA763228DAAB2C, 0x9B5D1293FFD5333D, 0x44DA7C38F318C33C, 0xE0F23BD2F729FE5A,
+        0xB453F0F77869A07F, 0x449EDB0414ACA630, 0x8BF71B3498A7D147, 0x4A8BF9D116C46171,
+        0xEF8EFD53268ED3E4, 0x9355C51B7DD240C4, 0x773B39348A9E4884, 0xF106311BF0AE9481,
+        0xC3220AF50F1D9E51, 0x883C1E87509A9155, 0x2CA8DF9E90D4200D, 0xC3607C98185E3F6B,
+        0x2DB2C17F123E2789, 0x8DEA7E64B060D80E, 0x79064E96E1586246, 0x3337B4067A6E14D1,
+        0xBEF8ACCE5DA3D05E, 0xAF4C92C1B95B98F2, 0x3637360006886C62, 0x0E8B477B1F19EF4E,
+        0x6C640BDE5DE79113, 0x676D5D9684B4C891, 0xB97C0F7DD581DCD7, 0xA056BF2F5F334F0A,
+        0x7B86A43401D2C524, 0xF64D5E0639AC15F1, 0x23BE8944E777CE37, 0x459431150B6D55B0,
+        0xB9DA40C26DE76061, 0xCB34702843AABE60, 0x1915EE40477A0B16, 0xF3546AD9E0AEC4C2,
+        0x9595343A07B330B7, 0x265F8D44474289CC, 0x6638F78377FCC7C8, 0x4D980A921B9FC08C,
+        0xCA73D00A32AF77CE, 0x57682E65D8B8310D, 0xC7D9C9317B484F2E, 0xA547A7DCB4389042,
+        0x298AA5B3F9F4DA2F, 0x3882D641A84DA7AE, 0x23D0BE56B18CA45B, 0x3FB9A9A44704CD7D,
+        0x454A26BF573BEC26, 0xFAC92F28020EBF7F, 0x06FF88324447B7E0, 0x3F01BDDA1E62CC5E,
+        0xE258BED9F6ED4A42, 0x201BE11EEACE8796, 0x9B5DDC767FB9F4A7, 0xD665EFC03014D46E,
+        0x0F3952540F0CEB8E, 0xF388264C9FEA68D0, 0xC501CE117C7DB405, 0x17BFF2B86CF41430
+    },
+    {
+        0xC7B1F7E361C2C9BD, 0x6EC204A5DAD94F0A, 0xA59BF96C7B9B8F07, 0x17498DDB178AC042,
+        0xE2AA79F586059B9C, 0x5196EA2CF22B172D, 0x7F56480AAE072FEB, 0x643053B918EAD4A9,
+        0x10E15A1A0D5C302B, 0xDD6174830E2B1502, 0xAFDC30BA94BE97E0, 0xE06485A37C7DA3D2,
+        0x4C2D2EF80E664CB6, 0xD55E6AF20A168BB0, 0x48C108682AC5B2C9, 0xCCC524488CFD5775,
+        0xD11D011861C6F085, 0x3A69FFC145086613, 0xFB14CA84C35D3A21, 0x9132A60AECBC6B5A,
+        0xB79A157974048994, 0x30F01298119F69BF, 0xEC46A26822DEB468, 0x7FD721DBF73712F5,
+        0x67035C6A26F050D4, 0xC0C76C39FB85A70B, 0xAFEEB62A65A72347, 0x5C7A974FA575D2B0,
+        0x6EA1F82819290D04, 0x21550B397B0A6E9A, 0x7830FD1E62961110, 0xFAFA1C2164B1134D,
+        0x0B3281A57E41D946, 0xFBBEA631CAD626AF, 0xAD934F23DDF98CCC, 0xB704243FA1A3B5CD,
+        0x80B79E656A18A692, 0x8C3DABF8715A2C61, 0xEF4CB74F7B167367, 0x42793257AE1D061F,
+        0x99168733128F7485, 0xF368DB8743355243, 0x041F18A267C4CD0A, 0xB225D7D066D341F8,
+        0xA9BE4E08EFDC4949, 0xB88275048B7DF31F, 0x205B2604C7C82206, 0x79D664264B3EB707,
+        0x3F2AF8DB0B3CAE37, 0x47E5B5C7FC24782C, 0x93770515D0EE3A44, 0x060364A79B6B843D,
+        0x23AD0CE9BD2C0EBF, 0x0A1FF12E8E00FE99, 0xC962364F76E7EC12, 0xEDC26ED84B935048,
+        0xD3EB0EE2D194B62F, 0xCEE736A0D1F6F9DE, 0x0FC3645F293D9759, 0xCCE0FD3AA9BC4FCC,
+        0x5AC6C3FF498239FC, 0x521BC6967270E756, 0x5927DB2C7CE9CB99, 0xE8F9E287EA8BEA4B
+    },
+    {
+        0xFAE32444503AF4F0, 0x97E0D3B64669D2B0, 0x6301F4634F0A70E2, 0x6F1D328700D11163,
+        0x1C82935AC04BD0A6, 0x9F79B9F66CE0ACB9, 0xF6661A66F3FE7BEF, 0x517B1CB0327AABE6,
+        0x8E98BDE937CCDB6C, 0x346B337CD95AD241, 0xF96F9902F9897045, 0x1163248310CC90CD,
+        0x60D4FF8D6346D781, 0xFCFCF6ED8C22EEEB, 0xFC1345AA59E9C81B, 0xBED243A1A5873A21,
+        0x90627DB857748C96, 0x589D2BFAA08E16AB, 0x033C501045030DB4, 0x686D3360FF1C78FB,
+        0xF25A4FB39A1C5FDD, 0xF70CAAB1650A7A93, 0x422C3AF3EC788023, 0xFE0626CEA3FFC388,
+        0x31E5F2421318D8B1, 0x40FE45F57432188B, 0x731BCBC74D12A33A, 0xAE67AC3799B2F512,
+        0xB9CB299D32EF24A4, 0xDF223AB3FC0D026A, 0x7F123ADA3B06124C, 0x12F367EB37CA1996,
+        0xC47E2063687BE2FD, 0xE28826306341CAEA, 0x64C87EBD860A9840, 0x04FA8BCCD1867A24,
+        0x04EA546B030F02FE, 0xA7C034E94DF9BF3C, 0x1A9241C1E6896059, 0x3D5E0BB2D38ECA2C,
+        0x16C0ED3EF1293119, 0x55D96E1D1364F17A, 0x838D0BD11C4524AA, 0x469F3CE59A51840C,
+        0x8C5A024C3390D74D, 0x7492B65D8E7E017E, 0x54575DDB1A37BDB0, 0x613E3182C3E8CC2A,
+        0x1F2E5E97752DCAE7, 0x43CF7CBD811C831A, 0x857D275C567411D8, 0xA5CFC2E3A8DBA2EE,
+        0xE1572D4DB5CB2100, 0xF60961E3222AB1D1, 0xDA045CD612363E15, 0x19E663DFD30C6064,
+        0x9C42D54E0E774D78, 0x9D1A32873B7B57D7, 0xF3E54F2A6B03D782, 0x3A2C233AC71C5C07,
+        0x269E00ECA2D3B96D, 0xAB3F1692E9366600, 0x65DB1308F98745A7, 0x8B635E786186CAB4
+    },
+    {
+        0x636A3F5C2DDB2702, 0xAC6829B6B8E8CAE2, 0x4534332530B3FFA2, 0x115258E6C9FE69AB,
+        0x11F1D3C1F0B39F00, 0xE9F700EBD74BA508, 0x9AD5D2ECA55F10F4, 0x54D66BFDE0B44C90,
+        0x3648A093E57D29B4, 0x22329F6D18755C87, 0xBEE5ABCFF262BB37, 0xEF0A90701FE9880D,
+        0xA70C8DD76E6775BD, 0xC1C229C32EBCA393, 0xC85A269B9E561478, 0x28BF9D942863EE72,
+        0xC929FF5FA82A6B37, 0x2CF385141E230A36, 0xBBFBCE847ADE37C3, 0x1561520FC45C6DEB,
+        0x0A5C72034B2C39FF, 0x7846A9B32A2BAD17, 0xCA265361C99A1F17, 0x68AF08EB0284A79F,
+        0x623ECB0AAE05A131, 0xD4F422219AA70BD2, 0x1E763C7A34E7B8E0, 0x3EE386BE56045609,
+        0x1569C6832AA6EEFB, 0x4E817A9AEA1AE58E, 0xE2BD1AE44DEB9174, 0x86135B81BF17A7A4,
+        0x066B4076AAAEDFA5, 0x50B8921F350FB0F5, 0xB045F2DB95D4F5E2, 0x2EA5085169D24C0E,
+        0x40D61F8F7E6EDC99, 0x5C5F409C1C39558C, 0xBA5EF8BE3368C16E, 0xAEEDB2973653FA25,
+        0x00D1C61881391BAA, 0xD4D6D90CE5E22B59, 0x10D82B08F3DDBADA, 0x9043DFFD91D52CA4,
+        0x808E3338884464B2, 0x9947A7847AB900FB, 0x389BA77EAAEC8731, 0x1237EEEE92BE7717,
+        0xA6A28B5165B92692, 0x95EC1DD7D03C3998, 0x0DF95700EA8BC6E0, 0x42491C09D5CE138F,
+        0xB81B4929A85A98E3, 0xE12936AA55C31592, 0xAF2B5E51BB3564D8, 0xB1C69296BD15C2F5,
+        0xAF11A2AF9E076A09, 0x23DE4402C2F0E9D4, 0xC136987FD8BE5D26, 0x6A63ABD829E05E19,
+        0xD9DD1CA1ED779C6B, 0x80153698E7B64276, 0xC0C571F4F74EBFF7, 0x7B2A38F4C4ED81F9
+    },
+    {
+        0x5145AC2A241E1B63, 0x25A64E023973DAE8, 0x02274BB7014ECBD4, 0x471C089EB2A36D85,
+        0xB37CBC9CEA267214, 0xCE93825AA8EDF895, 0xC4C2F33BAFB20BA3, 0xAE7C98A44A591722,
+        0x747E82262D160512, 0xE769AE6ED292F75F, 0x63CCC73AFF8A8239, 0x2462B90F437393D8,
+        0x1726D1ADAAF0929B, 0x014C88AC042F0212, 0xE51B3CC948D10A39, 0x6751887041621618,
+        0xA3496E2EBF96DABF, 0xA77BD79E09C8953E, 0x75CC4C0E3E552275, 0xB7E2D5115CC0DFED,
+        0x395C80BB439DEF8A, 0xDFC89A0462B9E54E, 0x96C5C1E745820B84, 0x0517829E8FEADEC3,
+        0x6EFAACD57F5352B8, 0x93837CD585804A59, 0x484C15169BA8B475, 0x71F8CF43D35D6C9A,
+        0xA2BA445B5036981E, 0xE386AF8D70B435B7, 0x9A60804C4F97B6F9, 0x1B506BBB64F3A64A,
+        0xC3F91E8EC812A1F4, 0x1D262B343D569705, 0x882C97936A7DCE10, 0x93E20049EEB7B380,
+        0xCAAB31566754D753, 0x37DB2CC07730215A, 0xA27D19F47EE36873, 0x1102D3C76F242299,
+        0x491C75C582FFF989, 0x6B86DEF9D8C69DE8, 0x2838E90033C04F70, 0x01E590416A6660DD,
+        0x2EA8C7BE8A1D79F8, 0xD68B82B9764DD802, 0x8170027D4C9C884B, 0x7B6A538CDBD62630,
+        0x88D6100B0DCA8908, 0x6B506467BCCF7DFA, 0xC976FE0B6F8232C0, 0x6613AEBFAEA438B6,
+        0x9CDCE7ABBB2DBCD4, 0x233D8462ECD507B3, 0x11E8FBA547720F92, 0xFB5157870B7E5FE4,
+        0xF5DBBA28EC91B474, 0x9CE245E66375094F, 0xBB232CD51CE0F0CD, 0xE244A45E0937D1C5,
+        0x2C0BEDDCDA12049D, 0x54BBF5B40B2E71F7, 0x2B79227D664D2521, 0x05DD0D53E1672796
+    },
+    {
+        0x76B227117311EA9C, 0x379BCBD6B5E458F2, 0x9B47106DE6B7B2BD, 0x0FE24BBB69A7EF9D,
+        0x97863B5241EEA919, 0xE85464C1612915FD, 0xF82496307A64FA58, 0x398A8E547A46F247,
+        0xD55DE41441CC177F, 0x05F4EF8FEBE534C4, 0xCB41468341AE5847, 0xAE67FB660BE3DE77,
+        0x5CDC8E5C44F8D827, 0xF0F1E491D9A83041, 0x9B892C9B121BA725, 0xC8AC0B436D6C99DF,
+        0xC782198BFC1CDE0C, 0xBBB2E67B55646107, 0x9B0E16C7E386A4CF, 0x99D87676E6B53F17,
+        0x6CCE9A8046BDB1DF, 0xC35479296DF4F2A5, 0x1FD879090C28B5DA, 0x975C5FD3BA57B6AD,
+        0x562BCE15F6C79B90, 0xBEBA76217486A397, 0xA0474D9CEAAF0561, 0xA1D5A800AF172879,
+        0x32B481539E7C93A5, 0xA1918FA6707277E2, 0x6C5E8CE14B6A1672, 0x2F3B5F0E8E5D6B29,
+        0x1AF6D1D253394B4B, 0x73BE96C2B50AC1B8, 0x13A1AD7638CCE512, 0xCC79437907D466B8,
+        0x0294AD89012E81CF, 0xA3B7C9CD6FBC84CB, 0x2317A8A96C9C2858, 0xFAFE96F2F5FD0229,
+        0x2D37946A18709D28, 0xF972FA2542559544, 0x47A394FE0BF8491E, 0x019BCD88551D8345,
+        0x12D02ABE94907739, 0x23A50F6854DAAB56, 0xAAA0AE47FAAC6C61, 0xB0FFF5ECCE2E84B9,
+        0xD23AAC7DC96E7BD0, 0x985363B3DC0ECD25, 0xD65DB49D7D512A86, 0x946DCEF0C3314668,
+        0x835414F570CD7013, 0x112FAF41DF0937BA, 0xD43A1E425588957A, 0xC5C71C807D6D5004,
+        0xEFE9E762C9293AA5, 0x8B1F6B264D037E97, 0x08C828B366CFD450, 0x0DB757609748EA77,
+        0xDF573F990412F26D, 0xFFA54AB8A68EB6C6, 0x64C4ADC2934ACA74, 0xCE90EBCDB0EC5D08
+    }
+};
+
+static const uint64_t zobrist_castle[16] PROGMEM = {
+    0x0000000000000000, 0x2CCBCAE5630FB359, 0x2E3626BEEEE5FBDB, 0x02FDEC5B8DEA4882,
+    0xBFDBA008DA4B4126, 0x93106AEDB944F27F, 0x91ED86B634AEBAFD, 0xBD264C5357A109A4,
+    0x803E52E1AC2D388D, 0xACF59804CF228BD4, 0xAE08745F42C8C356, 0x82C3BEBA21C7700F,
+    0x3FE5F2E9766679AB, 0x132E380C1569CAF2, 0x11D3D45798838270, 0x3D181EB2FB8C3129
+};
+
+static const uint64_t zobrist_ep_file[BOARD_SIZE] PROGMEM = {
+    0x3BE926F1C6F4F7B4, 0x102443F902554455, 0xABAE57DABEE6DCE0, 0xEC0A8DC892F0070A,
+    0x56544A1356554BAC, 0x8907B0501F3ADDB8, 0xC86ABDC9A218A0E5, 0x20AEC6944D2344BB
+};
+
+static const uint64_t zobrist_side PROGMEM = 0x1B82491A8F229185;
+
+#endif